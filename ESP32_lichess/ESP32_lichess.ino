@@ -5,32 +5,169 @@
     Normal:  <from><to>           e.g. e2e4
     Capture: <from><to><cap>      e.g. e5d6d5 (en-passant uses captured square)
     Castle:  <kfrom><kto><rfrom><rto>  e.g. e1g1h1f1 (8 chars)
+    With MOVE_TRACE each line gets a "#<seq>" suffix in both directions, e.g. e2e4#7
   - Serial Monitor and Serial2 treated as ATmega-originated moves
   - Suppresses sending streamed moves that exactly match last ATmega-originated payload
+  - Move POSTs / playing fetches reuse one keep-alive TLS session to the API host
+  - New/finished games come from the account event stream; /api/account/playing is
+    only polled while that stream is down
+  - Two FreeRTOS tasks: network/streams on core 0, serial bridge (Serial + Serial2) on
+    core 1, joined by lock-free single-producer/single-consumer queues
+  - Local moves wait in a pending queue until the game stream shows them; failed POSTs
+    are retried with bounded exponential backoff, 429 pauses posting
+  - Board tracking, stream parsing and payload building live in bridge_core.cpp, which
+    also builds natively (see host/)
+  - The tracking state is checkpointed to NVS after every stream update, so after a reboot
+    the game's gameFull only needs the moves played since; the ATmega gets "game <id>"
+    whenever a game is selected and keeps its own EEPROM checkpoint for that game
+  - The ATmega's occupancy ("occ" -> "oc:") is checked against the tracked position after
+    every move the gantry makes and every RESYNC_INTERVAL_MS; a difference that persists is put right with
+    "fix <from><to>" gantry moves, or reported square by square when a hand is needed
+  - "replay" on the Serial Monitor takes a PGN or UCI move list (end it with "go") and has
+    the ATmega play it on the board back to back, reporting per-move time, moves per
+    minute and placement failures; host/replay_sim.c takes the same input
   - Requires ArduinoJson (6.x)
 */
 
 #include <WiFi.h>
 #include <WiFiClientSecure.h>
+#include <Preferences.h>
 #include <ArduinoJson.h>
+#include <atomic>
+#include <stdarg.h>
+#include "bridge_core.h"
 #include "network_stuff.h" // must define WIFI_SSID, WIFI_PASS, LICHESS_API_TOKEN, LICHESS_USER
 
+// API endpoint. Define these in network_stuff.h to point the bridge at a local HTTPS
+// stand-in server; LICHESS_CA_CERT (PEM) enables certificate checking, otherwise insecure.
+#ifndef LICHESS_HOST
+#define LICHESS_HOST "lichess.org"
+#endif
+#ifndef LICHESS_PORT
+#define LICHESS_PORT 443
+#endif
+
+// Move latency tracing: moves on the ATmega link carry a "#n" sequence id (odd: detected on
+// the board, even: from the game stream) and both sides log "tr:<seq>:<point>:<us>" lines
+// here. ATmega lines are forwarded with our receive time appended so host/trace_timeline.py
+// can line up the two clocks. Set to 0 to send bare moves.
+#ifndef MOVE_TRACE
+#define MOVE_TRACE 1
+#endif
+
 const char* ssid = WIFI_SSID;
 const char* password = WIFI_PASS;
 const char* lichessToken = LICHESS_API_TOKEN;
 
-WiFiClientSecure httpsClient;
+WiFiClientSecure apiClient;    // keep-alive session for POSTs and short GETs
 WiFiClientSecure streamClient;
+WiFiClientSecure eventClient;  // /api/stream/event: gameStart / gameFinish
+
+// ---------- API session state ----------
+bool apiSessionOpen = false;
+unsigned long apiLastUsed = 0;
+const unsigned long API_IDLE_REFRESH_MS = 30UL * 1000UL; // reconnect before the server drops an idle session
+const unsigned long API_IO_TIMEOUT_MS = 5000;
+// A failed connect blocks for the TLS timeout, so apiSessionService() backs off after one
+const unsigned long API_CONNECT_RETRY_BASE_MS = 1000;
+const unsigned long API_CONNECT_RETRY_MAX_MS = 60UL * 1000UL;
+uint8_t apiConnectFailures = 0;       // in a row
+unsigned long nextConnectAttemptMs = 0;
+
+struct ApiStats {
+  uint32_t handshakes = 0;
+  uint32_t requests = 0;
+  uint32_t reused = 0;      // requests that went out on an already-open session
+  uint32_t failures = 0;
+  uint32_t lastHandshakeMs = 0;
+  uint32_t maxHandshakeMs = 0;
+  uint32_t lastRequestMs = 0; // request sent -> response fully read
+  uint32_t maxRequestMs = 0;
+  uint64_t totalRequestMs = 0;
+};
+ApiStats apiStats;
+
+// Opening an NDJSON stream: connect, TLS handshake, status line and headers
+struct StreamOpenStats {
+  uint32_t opens = 0;
+  uint32_t lastMs = 0;
+  uint32_t maxMs = 0;
+  uint32_t heapAfterOpen = 0;   // free heap right after the last open
+};
+StreamOpenStats streamOpenStats;
+int apiRetryAfterS = -1; // Retry-After of the last response, -1 if absent
+
+// ---------- Pending local moves ----------
+// A local move stays here until the game stream shows it applied; POST failures are
+// retried with exponential backoff instead of losing the move.
+struct PendingMove {
+  char uci[6];
+  char gameId[16];
+  bool posted;                 // server accepted the POST, waiting for the stream to show it
+  bool fromAtmega;
+  uint16_t seq;                // MOVE_TRACE id, 0 if untraced
+  uint8_t attempts;
+  unsigned long enqueuedMs;
+  unsigned long nextAttemptMs;
+  unsigned long postedMs;
+};
+const size_t PENDING_MAX = 8;
+PendingMove pendingMoves[PENDING_MAX];
+size_t pendingHead = 0;  // oldest entry
+size_t pendingCount = 0;
+unsigned long rateLimitedUntil = 0; // no POSTs before this (after a 429)
+
+const unsigned long RETRY_BASE_MS = 250;
+const unsigned long RETRY_MAX_MS = 8000;
+const uint8_t RETRY_MAX_ATTEMPTS = 8;
+const unsigned long RATE_LIMIT_DEFAULT_MS = 60UL * 1000UL; // lichess asks for a full minute after a 429
+const unsigned long ACK_TIMEOUT_MS = 15UL * 1000UL;        // posted but never seen on the stream
+
+struct PendingStats {
+  uint32_t queued = 0;
+  uint32_t acked = 0;        // seen on the game stream
+  uint32_t retries = 0;
+  uint32_t rateLimited = 0;
+  uint32_t dropped = 0;      // rejected, gave up, or game changed
+  uint32_t lastAckMs = 0;    // enqueue -> seen on stream
+  uint32_t maxAckMs = 0;
+  uint64_t totalAckMs = 0;
+};
+PendingStats pendingStats;
+
+// ---------- Board resync ----------
+// The ATmega's occupancy is compared with position_; a mismatch has to read the same twice,
+// RESYNC_CONFIRM_MS apart, before any piece is moved, so a hand still on the board is left alone.
+const unsigned long RESYNC_INTERVAL_MS = 30UL * 1000UL;
+const unsigned long RESYNC_CONFIRM_MS = 3UL * 1000UL;
+const uint8_t RESYNC_MAX_ATTEMPTS = 2;   // fix rounds per ply before leaving it to a hand
+unsigned long nextOccupancyCheck = 0;
+bool occupancyCheckDue = false;          // a move was sent to the ATmega: check once it is through it
+uint64_t mismatchOcc = 0;                // ATmega occupancy of the unconfirmed mismatch, 0 if none
+int resyncPly = -1;                      // ply the fix attempts below were made at
+uint8_t resyncAttempts = 0;
+
+struct ResyncStats {
+  uint32_t checks = 0;
+  uint32_t mismatches = 0;   // confirmed
+  uint32_t fixMoves = 0;
+  uint32_t manual = 0;       // mismatches left (partly) to a hand
+};
+ResyncStats resyncStats;
 
 unsigned long lastPlayingFetch = 0;
-const unsigned long PLAYING_FETCH_INTERVAL = 4UL * 1000UL; // 20s
+const unsigned long PLAYING_FETCH_INTERVAL = 4UL * 1000UL; // fallback poll while the event stream is down
 
-String currentGameId = "";
-bool streaming = false;
+// account event stream
+bool eventStreaming = false;
+unsigned long lastEventConnectAttempt = 0;
+unsigned long eventReconnectDelay = 0;
+const unsigned long EVENT_RECONNECT_MIN_MS = 2UL * 1000UL;
+const unsigned long EVENT_RECONNECT_MAX_MS = 60UL * 1000UL;
+const unsigned long STREAM_SILENCE_TIMEOUT_MS = 20UL * 1000UL; // lichess sends a keep-alive newline every ~7 s
 
-// ownership tracking
-String myColor = "";            // "white" or "black"
-String lastProcessedMove = "";  // last UCI move handled
+char currentGameId[16] = "";   // "" while no game is followed
+bool streaming = false;
 
 // Serial2 pins (adjust if needed)
 const int SERIAL2_RX = 16; // ESP32 RX pin
@@ -40,121 +177,173 @@ const long SERIAL2_BAUD = 9600;
 // If ATmega not connected, set false; still Serial Monitor will be used if you type
 bool atmegaConnected = true; // set true when you wire the ATmega
 
-// Track last move that came FROM the ATmega/Serial (payload format that would be sent to ATmega)
-String lastMoveFromAtmega = "";
-
-// Your lichess username (lowercased) - we'll initialize below
-String myLichessId;
-
-// minimal board representation for capture detection
-// board_[rank][file], rank 0 = '1', file 0 = 'a'
-char board_[8][8];
-
 WiFiClientSecure client; // helper
 
-// ---------- Helper: board utilities ----------
-int fileCharToX(char f) { return (f - 'a'); }
-int rankCharToY(char r) { return (r - '1'); }
-String coordsXYtoSquare(int x, int y) {
-  String s = "";
-  s += char('a' + x);
-  s += char('1' + y);
-  return s;
-}
-
-void setBoardSquare(int x, int y, char piece) {
-  if (x < 0 || x > 7 || y < 0 || y > 7) return;
-  board_[y][x] = piece;
-}
-char getBoardSquare(int x, int y) {
-  if (x < 0 || x > 7 || y < 0 || y > 7) return ' ';
-  return board_[y][x];
-}
-
-void initBoardFromFEN() {
-  // Standard start position
-  const char* fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
-  int x = 0, y = 7; // FEN starts rank8 -> rank1
-  for (const char* p = fen; *p && *p != ' '; ++p) {
-    char c = *p;
-    if (c == '/') { y--; x = 0; }
-    else if (c >= '1' && c <= '8') {
-      int n = c - '0';
-      for (int i = 0; i < n; ++i) board_[y][x++] = ' ';
-    } else {
-      board_[y][x++] = c;
-    }
+// ---------- Stream buffering (no heap use per line) ----------
+// Bytes from a streaming client land in a fixed ring; complete NDJSON lines are copied
+// out into line, which ArduinoJson then parses in place (zero-copy).
+template <size_t RING_SIZE, size_t LINE_MAX> // RING_SIZE must be a power of two
+struct LineReader {
+  char ring[RING_SIZE];
+  size_t head = 0; // next write index (free-running)
+  size_t tail = 0; // start of the current line (free-running)
+  size_t scan = 0; // where the newline search resumes (free-running)
+  char line[LINE_MAX];
+  uint32_t droppedLines = 0; // longer than LINE_MAX
+  unsigned long lastByteMs = 0;
+
+  void reset() {
+    head = tail = scan = 0;
+    lastByteMs = millis();
   }
-}
-
-// Build the "payload" that we send to ATmega for a simple UCI (non-capture) move
-String buildPayloadForUciSimple(const String &uci) {
-  if (uci.length() < 4) return "";
-  String fromSq = uci.substring(0,2);
-  String toSq   = uci.substring(2,4);
-  return fromSq + toSq; // e2e4
-}
-
-// Apply UCI move to our board and determine capture square if any.
-// Returns capture square string if capture happened, else empty string.
-// Handles promotions, castling, en-passant best-effort.
-String applyUciMoveToBoard(const String &uci) {
-  if (uci.length() < 4) return "";
 
-  int fromX = fileCharToX(uci[0]);
-  int fromY = rankCharToY(uci[1]);
-  int toX   = fileCharToX(uci[2]);
-  int toY   = rankCharToY(uci[3]);
-
-  char piece = getBoardSquare(fromX, fromY);
-  char destPiece = getBoardSquare(toX, toY);
+  // Pull whatever the client has into the ring and copy the next complete line into line.
+  // Returns the trimmed line length, 0 if no complete line is buffered yet.
+  size_t readLine(WiFiClientSecure& c) {
+    uint8_t chunk[256];
+    while (c.available()) {
+      size_t space = RING_SIZE - (head - tail);
+      if (space == 0) break;
+      int n = c.read(chunk, min(space, sizeof(chunk)));
+      if (n <= 0) break;
+      for (int i = 0; i < n; i++) ring[(head++) & (RING_SIZE - 1)] = (char)chunk[i];
+      lastByteMs = millis();
+    }
 
-  bool isCapture = false;
-  int capX = toX, capY = toY;
+    while (scan != head) {
+      if (ring[scan & (RING_SIZE - 1)] != '\n') { scan++; continue; }
 
-  // Detect en-passant: pawn moves diagonally into an empty square: captured pawn is on (toX, fromY)
-  bool possiblePawn = (piece == 'P' || piece == 'p');
-  if (possiblePawn && abs(toX - fromX) == 1 && toY != fromY && destPiece == ' ') {
-    isCapture = true;
-    capX = toX; capY = fromY;
-  } else {
-    if (destPiece != ' ') {
-      isCapture = true;
-      capX = toX; capY = toY;
+      size_t lineLen = scan - tail;
+      scan++;
+      if (lineLen >= LINE_MAX) {
+        droppedLines++;
+        tail = scan;
+        continue;
+      }
+      for (size_t i = 0; i < lineLen; i++) line[i] = ring[(tail + i) & (RING_SIZE - 1)];
+      tail = scan;
+
+      // trim whitespace / '\r' in place
+      size_t first = 0;
+      while (first < lineLen && isspace((unsigned char)line[first])) first++;
+      while (lineLen > first && isspace((unsigned char)line[lineLen - 1])) lineLen--;
+      if (lineLen == first) continue; // keep-alive blank line
+      if (first) memmove(line, line + first, lineLen - first);
+      lineLen -= first;
+      line[lineLen] = '\0';
+      return lineLen;
     }
-  }
 
-  // Handle castling rook move (simple)
-  if ((piece == 'K' || piece == 'k') && abs(toX - fromX) == 2) {
-    if (toX == 6) { // king-side g-file
-      int rookFromX = 7, rookToX = 5, rookY = fromY;
-      char rookPiece = getBoardSquare(rookFromX, rookY);
-      setBoardSquare(rookFromX, rookY, ' ');
-      setBoardSquare(rookToX, rookY, rookPiece);
-    } else if (toX == 2) { // queen-side c-file
-      int rookFromX = 0, rookToX = 3, rookY = fromY;
-      char rookPiece = getBoardSquare(rookFromX, rookY);
-      setBoardSquare(rookFromX, rookY, ' ');
-      setBoardSquare(rookToX, rookY, rookPiece);
+    // A full ring without a newline can never complete: drop it
+    if (head - tail == RING_SIZE) {
+      droppedLines++;
+      tail = scan = head;
     }
+    return 0;
   }
-
-  // Move piece
-  setBoardSquare(fromX, fromY, ' ');
-
-  // promotion
-  if (uci.length() == 5) {
-    char promo = uci[4];
-    bool isWhite = (piece >= 'A' && piece <= 'Z');
-    char pchar = isWhite ? char(toupper(promo)) : char(tolower(promo));
-    setBoardSquare(toX, toY, pchar);
-  } else {
-    setBoardSquare(toX, toY, piece);
+};
+
+LineReader<4096, 3072> gameStream;  // gameFull of a long game still fits
+LineReader<1024, 1024> eventStream;
+
+
+// ---------- Task split ----------
+// Single-producer / single-consumer ring: one task pushes, the other pops, no locks.
+template <typename T, size_t N> // N must be a power of two
+struct SpscQueue {
+  T items[N];
+  std::atomic<size_t> head{0}; // written only by the producer
+  std::atomic<size_t> tail{0}; // written only by the consumer
+
+  bool push(const T& v) {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) == N) return false;
+    items[h & (N - 1)] = v;
+    head.store(h + 1, std::memory_order_release);
+    return true;
   }
-
-  if (isCapture) return coordsXYtoSquare(capX, capY);
-  return "";
-}
+  bool pop(T& v) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) return false;
+    v = items[t & (N - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+  size_t size() const { return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire); }
+};
+
+// net task -> serial task: payload for the ATmega (opponent / streamed move), or a
+// "reset" / "game <id>" command
+const size_t INBOUND_MAX = 16;
+struct InboundMove {
+  char payload[INBOUND_MAX];
+  uint16_t seq;
+  uint32_t queuedUs;
+};
+// serial task -> net task: line from the ATmega or Serial Monitor
+struct OutboundMove {
+  char text[PAYLOAD_MAX]; // UCI to post, or a raw capture/castle payload
+  bool post;              // false: only record for echo suppression
+  bool fromAtmega;
+  uint16_t seq;
+  uint32_t queuedUs;
+};
+// serial task -> net task: "oc:" answer to an "occ" request
+struct OccupancyReply {
+  int ply;                // plyCount the request was sent at
+  uint64_t occ;           // bit = square, as cc_occupancy()
+  int state;              // ATmega move detection state, 0 = idle
+};
+SpscQueue<InboundMove, 8> inboundMoves;
+SpscQueue<OutboundMove, 8> outboundMoves;
+SpscQueue<OccupancyReply, 4> occupancyReplies;
+
+const BaseType_t NET_TASK_CORE = 0;    // same core as the WiFi stack
+const BaseType_t SERIAL_TASK_CORE = 1;
+const uint32_t NET_TASK_STACK = 16384; // TLS handshakes run on this stack
+const uint32_t SERIAL_TASK_STACK = 4096;
+TaskHandle_t netTaskHandle = nullptr;
+TaskHandle_t serialTaskHandle = nullptr;
+
+struct TaskStats {
+  uint32_t loops = 0;
+  uint32_t lastLoopUs = 0;
+  uint32_t maxLoopUs = 0;   // longest single pass (a TLS handshake shows up here)
+  uint32_t maxQueueUs = 0;  // longest time a move it consumed sat in its input queue
+  uint32_t queueFull = 0;   // moves dropped because its output queue was full
+};
+TaskStats netTaskStats;
+TaskStats serialTaskStats;
+
+// Serial lines are assembled a byte at a time so a partial line never blocks the serial task
+struct SerialLine {
+  char buf[128];          // a PGN export line is at most 80 characters
+  size_t len = 0;
+};
+SerialLine monitorLine;
+SerialLine atmegaLine;
+
+uint16_t streamSeq = 0;   // last even MOVE_TRACE id handed to a streamed move
+
+// ---------- Hardware replay (serial task) ----------
+// "replay" collects moves from the Serial Monitor until "go", then feeds them to the ATmega
+// as "rp <payload>", the next one as soon as it answers the last. "replay stop" ends early.
+const size_t REPLAY_MAX_MOVES = 400;
+struct Replay {
+  bool loading = false;
+  bool running = false;
+  cc_position_t pos;                    // position after the moves loaded so far
+  char payloads[REPLAY_MAX_MOVES][PAYLOAD_MAX];
+  size_t count = 0;
+  size_t next = 0;                      // next payload to send
+  unsigned long startMs = 0;
+};
+Replay replay;
+
+// NVS namespace for the bridge_core checkpoint. NVS is log-structured and spreads writes over
+// its flash pages itself, so one key rewritten per move needs no wear leveling of our own.
+Preferences prefs;
+const char* CHECKPOINT_KEY = "ckpt";
 
 // ---------- Networking helpers ----------
 void connectWiFi() {
@@ -167,308 +356,593 @@ void connectWiFi() {
   Serial.println(" connected.");
 }
 
-bool httpGetJson(const char* host, const String& path, String& outBody) {
-  httpsClient.setInsecure();
-  if (!httpsClient.connect(host, 443)) {
+void configureTls(WiFiClientSecure& c) {
+#ifdef LICHESS_CA_CERT
+  c.setCACert(LICHESS_CA_CERT);
+#else
+  c.setInsecure();
+#endif
+}
+
+void apiSessionClose() {
+  apiClient.stop();
+  apiSessionOpen = false;
+}
+
+// Open (or reopen) the keep-alive session; the TLS handshake time is recorded
+bool apiSessionConnect() {
+  apiSessionClose();
+  configureTls(apiClient);
+  apiClient.setTimeout(API_IO_TIMEOUT_MS);
+  unsigned long t0 = millis();
+  if (!apiClient.connect(LICHESS_HOST, LICHESS_PORT)) {
     Serial.println("HTTPS connect failed");
+    apiStats.failures++;
+    if (apiConnectFailures < 16) apiConnectFailures++;
+    nextConnectAttemptMs = millis() + min(API_CONNECT_RETRY_BASE_MS << (apiConnectFailures - 1), API_CONNECT_RETRY_MAX_MS);
     return false;
   }
-  httpsClient.printf("GET %s HTTP/1.1\r\nHost: %s\r\nAuthorization: Bearer %s\r\nAccept: application/json\r\nConnection: close\r\n\r\n",
-                    path.c_str(), host, lichessToken);
+  apiConnectFailures = 0;
+  nextConnectAttemptMs = millis();
+  uint32_t dt = millis() - t0;
+  apiStats.handshakes++;
+  apiStats.lastHandshakeMs = dt;
+  if (dt > apiStats.maxHandshakeMs) apiStats.maxHandshakeMs = dt;
+  apiSessionOpen = true;
+  apiLastUsed = millis();
+  return true;
+}
 
-  String statusLine = httpsClient.readStringUntil('\n');
-  if (!statusLine.startsWith("HTTP/1.1 200")) {
-    Serial.println("HTTP GET failed: " + statusLine);
-    while (httpsClient.connected()) { if (httpsClient.available()) httpsClient.read(); else delay(1); }
-    httpsClient.stop();
-    return false;
+// Called from netTask(): keep a warm session while a game is on, and replace it ahead of
+// time once it has sat idle long enough that the server may be about to close it. After a
+// failed connect it waits out the backoff, so an outage doesn't stall the stream reads.
+void apiSessionService() {
+  if (WiFi.status() != WL_CONNECTED) return;
+  if (apiSessionOpen && !apiClient.connected()) apiSessionClose();
+  if ((long) (millis() - nextConnectAttemptMs) < 0) return;
+  if (apiSessionOpen && millis() - apiLastUsed > API_IDLE_REFRESH_MS) apiSessionConnect();
+  else if (!apiSessionOpen && streaming) apiSessionConnect();
+}
+
+// Read one header line into buf without the trailing CR/LF. Returns false on timeout.
+bool apiReadLine(char* buf, size_t size) {
+  size_t n = apiClient.readBytesUntil('\n', buf, size - 1);
+  if (n == 0 && !apiClient.connected()) return false;
+  if (n && buf[n - 1] == '\r') n--;
+  buf[n] = '\0';
+  return true;
+}
+
+// Read exactly n body bytes, keeping what fits in body (bodyLen tracks how much was kept)
+bool apiReadBody(size_t n, char* body, size_t bodySize, size_t& bodyLen) {
+  char scratch[128];
+  while (n > 0) {
+    size_t want = min(n, sizeof(scratch));
+    size_t got = apiClient.readBytes(scratch, want);
+    if (got == 0) return false;
+    if (body) {
+      size_t keep = min(got, bodySize - 1 - bodyLen);
+      memcpy(body + bodyLen, scratch, keep);
+      bodyLen += keep;
+    }
+    n -= got;
   }
+  return true;
+}
 
-  // Skip headers
-  while (httpsClient.connected()) {
-    String line = httpsClient.readStringUntil('\n');
-    if (line == "\r" || line == "") break;
+// One request on the session. Returns the HTTP status code, or -1 if the connection failed
+// before a status line arrived. The response is always read to the end so the session can be reused.
+int apiRequestOnce(const char* method, const char* path, char* body, size_t bodySize) {
+  apiClient.printf("%s %s HTTP/1.1\r\nHost: %s\r\nAuthorization: Bearer %s\r\nAccept: application/json\r\nContent-Length: 0\r\nConnection: keep-alive\r\n\r\n",
+                   method, path, LICHESS_HOST, lichessToken);
+
+  char line[128];
+  if (!apiReadLine(line, sizeof(line)) || strncmp(line, "HTTP/1.", 7) != 0) return -1;
+  int status = atoi(line + 9);
+  apiRetryAfterS = -1;
+
+  long contentLength = -1;
+  bool chunked = false;
+  bool serverCloses = false;
+  while (apiReadLine(line, sizeof(line)) && line[0]) {
+    if (strncasecmp(line, "Content-Length:", 15) == 0) contentLength = atol(line + 15);
+    else if (strncasecmp(line, "Transfer-Encoding:", 18) == 0 && strstr(line, "chunked")) chunked = true;
+    else if (strncasecmp(line, "Connection:", 11) == 0 && strstr(line, "close")) serverCloses = true;
+    else if (strncasecmp(line, "Retry-After:", 12) == 0) apiRetryAfterS = atoi(line + 12);
   }
 
-  outBody = "";
-  while (httpsClient.connected() || httpsClient.available()) {
-    if (httpsClient.available()) outBody += (char)httpsClient.read();
-    else delay(1);
+  size_t bodyLen = 0;
+  bool complete = true;
+  if (chunked) {
+    for (;;) {
+      if (!apiReadLine(line, sizeof(line))) { complete = false; break; }
+      size_t chunk = strtoul(line, nullptr, 16);
+      if (chunk == 0) {
+        apiReadLine(line, sizeof(line)); // blank line after the last chunk
+        break;
+      }
+      if (!apiReadBody(chunk, body, bodySize, bodyLen)) { complete = false; break; }
+      apiReadLine(line, sizeof(line)); // CRLF after chunk data
+    }
+  } else if (contentLength >= 0) {
+    complete = apiReadBody((size_t) contentLength, body, bodySize, bodyLen);
+  } else {
+    // no length: body runs until the server closes
+    char scratch[128];
+    while (apiClient.connected() || apiClient.available()) {
+      size_t got = apiClient.readBytes(scratch, sizeof(scratch));
+      if (body) {
+        size_t keep = min(got, bodySize - 1 - bodyLen);
+        memcpy(body + bodyLen, scratch, keep);
+        bodyLen += keep;
+      }
+    }
+    serverCloses = true;
   }
-  httpsClient.stop();
-  return true;
+  if (body) body[bodyLen] = '\0';
+
+  if (serverCloses || !complete) apiSessionClose();
+  return status;
 }
 
-bool httpPostNoBody(const char* host, const String& path, String& outStatus) {
-  WiFiClientSecure client;
-  client.setInsecure();
-  if (!client.connect(host, 443)) {
-    outStatus = "connect fail";
-    return false;
+// Send a request over the keep-alive session, connecting if needed. A session that turns out to
+// be stale (closed before any response) is reopened and the request retried once.
+int apiRequest(const char* method, const char* path, char* body, size_t bodySize) {
+  if (WiFi.status() != WL_CONNECTED) return -1;
+  bool reused = apiSessionOpen && apiClient.connected();
+  if (!reused && !apiSessionConnect()) return -1;
+
+  unsigned long t0 = millis();
+  int status = apiRequestOnce(method, path, body, bodySize);
+  if (status < 0 && reused) {
+    reused = false;
+    if (apiSessionConnect()) {
+      t0 = millis();
+      status = apiRequestOnce(method, path, body, bodySize);
+    }
   }
-  client.printf("POST %s HTTP/1.1\r\nHost: %s\r\nAuthorization: Bearer %s\r\nContent-Length: 0\r\nConnection: close\r\n\r\n",
-                path.c_str(), host, lichessToken);
+  apiLastUsed = millis();
 
-  String statusLine = client.readStringUntil('\n');
-  outStatus = statusLine;
-  while (client.connected()) { if (client.available()) client.read(); else delay(1); }
-  client.stop();
-  return statusLine.startsWith("HTTP/1.1 200") || statusLine.startsWith("HTTP/1.1 201") || statusLine.startsWith("HTTP/1.1 204");
+  if (status < 0) {
+    apiSessionClose();
+    apiStats.failures++;
+    return -1;
+  }
+  uint32_t dt = millis() - t0;
+  apiStats.requests++;
+  if (reused) apiStats.reused++;
+  apiStats.lastRequestMs = dt;
+  apiStats.totalRequestMs += dt;
+  if (dt > apiStats.maxRequestMs) apiStats.maxRequestMs = dt;
+  return status;
 }
 
-// Parse /api/account/playing JSON and pick a game id (first)
-String parsePlayingForGameId(const String& json) {
-  StaticJsonDocument<2048> doc;
-  DeserializationError err = deserializeJson(doc, json);
-  if (err) {
-    Serial.println("parsePlayingForGameId JSON error: " + String(err.c_str()));
-    return "";
+bool httpGetJson(const char* path, char* outBody, size_t outSize) {
+  int status = apiRequest("GET", path, outBody, outSize);
+  if (status != 200) {
+    Serial.printf("HTTP GET %s failed: %d\n", path, status);
+    return false;
   }
-  if (!doc.containsKey("nowPlaying")) return "";
-  JsonArray arr = doc["nowPlaying"].as<JsonArray>();
-  if (arr.size() == 0) return "";
-  for (JsonVariant v : arr) {
-    if (v.containsKey("id")) return String((const char*)v["id"]);
-    if (v.containsKey("gameId")) return String((const char*)v["gameId"]);
+  return true;
+}
+
+// Returns the HTTP status code (-1 if no response)
+int httpPostNoBody(const char* path) {
+  return apiRequest("POST", path, nullptr, 0);
+}
+
+// Switch to gameId: drop any current game stream, reset the board and stream the new game
+void selectGame(const char* gid) {
+  Serial.printf("Selected game: %s\n", gid);
+  strlcpy(currentGameId, gid, sizeof(currentGameId));
+  if (streaming) {
+    streamClient.stop();
+    streaming = false;
   }
-  return "";
+  delay(50);
+  // reset board to start (we'll reconstruct from moves, or resume from the checkpoint)
+  resetMoveTracking();
+  // the ATmega keeps its tracked position if this is the game it already has
+  InboundMove in;
+  snprintf(in.payload, sizeof(in.payload), "game %s", currentGameId);
+  in.seq = 0;
+  in.queuedUs = micros();
+  if (!inboundMoves.push(in)) netTaskStats.queueFull++;
+  startGameStream(currentGameId);
 }
 
 void fetchPlayingGames() {
-  String body;
+  static char body[2048];
   Serial.println("Fetching /api/account/playing ...");
-  if (!httpGetJson("lichess.org", "/api/account/playing", body)) {
+  if (!httpGetJson("/api/account/playing", body, sizeof(body))) {
     Serial.println("Failed to fetch playing");
     return;
   }
-  String gid = parsePlayingForGameId(body);
-  if (gid.length() > 0) {
-    if (gid != currentGameId) {
-      Serial.println("Selected game: " + gid);
-      currentGameId = gid;
-      if (streaming) {
-        streamClient.stop();
-        streaming = false;
-      }
-      delay(50);
-      // reset board to start (we'll reconstruct from moves)
-      initBoardFromFEN();
-      startGameStream(currentGameId);
-    }
+  char gid[16];
+  if (parsePlayingForGameId(body, gid, sizeof(gid))) {
+    if (strcmp(currentGameId, gid) != 0) selectGame(gid);
   } else {
     Serial.println("No active game found.");
   }
 }
 
-void startGameStream(const String& gameId) {
-  if (gameId.length() == 0) return;
-  Serial.println("Starting stream for game: " + gameId);
-  streamClient.setInsecure();
-  if (!streamClient.connect("lichess.org", 443)) {
-    Serial.println("Stream connect failed");
-    return;
+// Send a streaming GET on c and skip the response headers. Returns false (connection closed)
+// unless the server answered 200.
+bool openNdjsonStream(WiFiClientSecure& c, const char* path) {
+  uint32_t t0 = millis();
+  configureTls(c);
+  if (!c.connect(LICHESS_HOST, LICHESS_PORT)) {
+    Serial.printf("Stream connect failed: %s\n", path);
+    return false;
   }
-
-  String path = "/api/board/game/stream/" + gameId;
-  streamClient.printf("GET %s HTTP/1.1\r\nHost: lichess.org\r\nAuthorization: Bearer %s\r\nAccept: application/x-ndjson\r\nConnection: keep-alive\r\n\r\n",
-                      path.c_str(), lichessToken);
-
-  String status = streamClient.readStringUntil('\n');
-  if (!status.startsWith("HTTP/1.1 200")) {
-    Serial.println("Stream HTTP error: " + status);
-    while (streamClient.connected()) { if (streamClient.available()) streamClient.read(); else delay(1); }
-    streamClient.stop();
-    return;
+  c.printf("GET %s HTTP/1.1\r\nHost: %s\r\nAuthorization: Bearer %s\r\nAccept: application/x-ndjson\r\nConnection: keep-alive\r\n\r\n",
+           path, LICHESS_HOST, lichessToken);
+
+  // status line and headers into one fixed buffer; a header longer than it is read in pieces
+  char lh[96];
+  size_t n = c.readBytesUntil('\n', lh, sizeof(lh) - 1);
+  lh[n] = '\0';
+  if (strncmp(lh, "HTTP/1.1 200", 12) != 0) {
+    Serial.printf("Stream HTTP error: %s\n", lh);
+    c.stop();
+    return false;
   }
-  while (streamClient.connected()) {
-    String lh = streamClient.readStringUntil('\n');
-    if (lh == "\r" || lh == "") break;
+  bool partial = false;
+  while (c.connected()) {
+    n = c.readBytesUntil('\n', lh, sizeof(lh) - 1);
+    bool blank = !partial && (n == 0 || (n == 1 && lh[0] == '\r'));
+    partial = n == sizeof(lh) - 1;
+    if (blank) break;
   }
+  uint32_t dt = millis() - t0;
+  streamOpenStats.opens++;
+  streamOpenStats.lastMs = dt;
+  if (dt > streamOpenStats.maxMs) streamOpenStats.maxMs = dt;
+  streamOpenStats.heapAfterOpen = ESP.getFreeHeap();
+  return true;
+}
+
+void startGameStream(const char* gameId) {
+  if (!gameId[0]) return;
+  Serial.printf("Starting stream for game: %s\n", gameId);
+  char path[48];
+  snprintf(path, sizeof(path), "/api/board/game/stream/%s", gameId);
+  if (!openNdjsonStream(streamClient, path)) return;
+  gameStream.reset();
   streaming = true;
   Serial.println("Stream open.");
 }
 
-String readStreamLine() {
-  String line = "";
-  unsigned long start = millis();
-  while (streamClient.connected()) {
-    if (streamClient.available()) {
-      char c = streamClient.read();
-      line += c;
-      if (c == '\n') break;
-    } else {
-      if (millis() - start > 200) break;
-      delay(1);
+void startEventStream() {
+  lastEventConnectAttempt = millis();
+  Serial.println("Starting account event stream");
+  if (!openNdjsonStream(eventClient, "/api/stream/event")) {
+    // back off, doubling up to EVENT_RECONNECT_MAX_MS; polling covers the gap
+    eventReconnectDelay = eventReconnectDelay ? min(eventReconnectDelay * 2, EVENT_RECONNECT_MAX_MS) : EVENT_RECONNECT_MIN_MS;
+    return;
+  }
+  eventStream.reset();
+  eventStreaming = true;
+  eventReconnectDelay = 0;
+  Serial.println("Event stream open.");
+}
+
+// gameStart / gameFinish from the account event stream
+void handleEventLine(char* line, size_t len) {
+  const char* type;
+  const char* gid;
+  if (!parseEventLine(line, len, &type, &gid)) return;
+
+  if (strcmp(type, "gameStart") == 0) {
+    if (!streaming) selectGame(gid);
+    else if (strcmp(currentGameId, gid) != 0) Serial.printf("Game %s started, still following %s\n", gid, currentGameId);
+  } else if (strcmp(type, "gameFinish") == 0) {
+    Serial.printf("Game finished: %s\n", gid);
+    if (strcmp(currentGameId, gid) == 0) {
+      // have the ATmega put the pieces back for the next game
+      InboundMove in;
+      strlcpy(in.payload, "reset", sizeof(in.payload));
+      in.seq = 0;
+      in.queuedUs = micros();
+      if (!inboundMoves.push(in)) netTaskStats.queueFull++;
+      streamClient.stop();
+      streaming = false;
+      currentGameId[0] = '\0';
     }
   }
-  line.trim();
-  return line;
 }
 
-// Process NDJSON stream lines; update board and send to ATmega (raw) unless suppressed
-void handleStreamLine(const String& line) {
-  if (line.length() == 0) return;
-  if (line.length() < 5 || line[0] != '{') return;
+// ---------- Move tracing ----------
+void traceMove(uint16_t seq, const char* point) {
+#if MOVE_TRACE
+  if (seq) Serial.printf("tr:%u:%s:%lu\n", (unsigned) seq, point, (unsigned long) micros());
+#endif
+}
 
-  StaticJsonDocument<3072> doc; // increased a bit for nested objects
-  DeserializationError err = deserializeJson(doc, line);
-  if (err) return;
+// "tr:<seq>:<point>:<atmega us>" from the ATmega, logged with our receive time
+void forwardAtmegaTrace(const char* line) {
+#if MOVE_TRACE
+  Serial.printf("%s:%lu\n", line, (unsigned long) micros());
+#endif
+}
 
-  const char* type = doc["type"];
-  if (!type) return;
-  String t = String(type);
+// ---------- bridge_core hooks ----------
+void bridgeLog(const char* fmt, ...) {
+  char buf[160];
+  va_list ap;
+  va_start(ap, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+  Serial.print(buf);
+}
 
-  if (t == "gameFull") {
-    // Determine white/black user ids
-    String whiteUserId = "";
-    String blackUserId = "";
-    if (doc.containsKey("white")) {
-      if (doc["white"].containsKey("id")) whiteUserId = String((const char*)doc["white"]["id"]);
-      else if (doc["white"].containsKey("user") && doc["white"]["user"].containsKey("name"))
-        whiteUserId = String((const char*)doc["white"]["user"]["name"]);
-    }
-    if (doc.containsKey("black")) {
-      if (doc["black"].containsKey("id")) blackUserId = String((const char*)doc["black"]["id"]);
-      else if (doc["black"].containsKey("user") && doc["black"]["user"].containsKey("name"))
-        blackUserId = String((const char*)doc["black"]["user"]["name"]);
-    }
+uint32_t bridgeMicros() {
+  return micros();
+}
 
-    // lowercase comparison to avoid case mismatch
-    whiteUserId.toLowerCase();
-    blackUserId.toLowerCase();
+void bridgeSaveCheckpoint(const BridgeCheckpoint& cp) {
+  if (prefs.putBytes(CHECKPOINT_KEY, &cp, sizeof(cp)) != sizeof(cp)) Serial.println("Checkpoint write failed");
+}
 
-    if (myLichessId.length() == 0) {
-      // ensure our stored id is lowercased (in case setup didn't)
-      myLichessId = String(LICHESS_USER);
-      myLichessId.toLowerCase();
-    }
+// Every move the game stream applies: acknowledge our pending POSTs, and forward new
+// opponent moves to the serial task for the ATmega
+void bridgeOnStreamMove(const BridgeMove& mv) {
+  // on a silent replay only the final move can be one we are still waiting for
+  if (mv.emit || mv.lastInList) ackPendingMove(mv.uci);
+  if (!mv.emit) return;
 
-    if (myLichessId == whiteUserId) myColor = "white";
-    else if (myLichessId == blackUserId) myColor = "black";
-    else myColor = "";
-
-    Serial.println("White user: " + whiteUserId);
-    Serial.println("Black user: " + blackUserId);
-    Serial.println("Me (API id): " + myLichessId);
-    Serial.println("Detected color: " + myColor);
-
-    // Reconstruct initial board and apply moves from "initialFen"/"state" or "moves" if provided
-    initBoardFromFEN();
-    if (doc.containsKey("state") && doc["state"].containsKey("moves")) {
-      String movesStr = String((const char*)doc["state"]["moves"]);
-      movesStr.trim();
-      if (movesStr.length()) {
-        int start = 0;
-        while (start < movesStr.length()) {
-          int sp = movesStr.indexOf(' ', start);
-          String m;
-          if (sp == -1) { m = movesStr.substring(start); start = movesStr.length(); }
-          else { m = movesStr.substring(start, sp); start = sp + 1; }
-          m.trim();
-          if (m.length() >= 4) {
-            applyUciMoveToBoard(m);
-            lastProcessedMove = m;
-          }
-        }
-      }
-    }
+  if (mv.suppressed) {
+    Serial.printf("%s (suppressed send to ATmega): %s\n", mv.isMyMove ? "MY MOVE" : "OPPONENT MOVE", mv.payload);
+    return;
+  }
+  // check the board once the gantry has made the move; moves made by hand are left to
+  // the periodic check
+  occupancyCheckDue = true;
+  // send raw payload to ATmega (no prefixes)
+  Serial.printf("%s detected: %s%s%s\n", mv.isMyMove ? "MY MOVE" : "OPPONENT MOVE", mv.uci,
+                mv.captureSq[0] ? "  capture at " : "", mv.captureSq);
+  Serial.printf(" -> send to ATmega: %s\n", mv.payload);
+  InboundMove in;
+  strlcpy(in.payload, mv.payload, sizeof(in.payload));
+  streamSeq = (uint16_t) ((streamSeq + 2) & 0x7FFE);
+  if (streamSeq == 0) streamSeq = 2;
+  in.seq = streamSeq;
+  traceMove(in.seq, "e.stream");
+  in.queuedUs = micros();
+  if (!inboundMoves.push(in)) {
+    netTaskStats.queueFull++;
+    Serial.printf("Inbound queue full, dropped: %s\n", mv.payload);
+  }
+}
+
+// Heap and stream-handling figures; "largest block" well below "free" means fragmentation
+void printBridgeStats() {
+  Serial.printf("heap free: %u  min free: %u  largest block: %u\n",
+                (unsigned) ESP.getFreeHeap(), (unsigned) ESP.getMinFreeHeap(), (unsigned) ESP.getMaxAllocHeap());
+  Serial.printf("stream lines: %u  moves: %u  parse errors: %u  dropped: %u\n",
+                (unsigned) streamStats.lines, (unsigned) streamStats.moves,
+                (unsigned) streamStats.parseErrors, (unsigned) gameStream.droppedLines);
+  Serial.printf("handleStreamLine us: last %u  max %u  mean %u\n",
+                (unsigned) streamStats.lastUs, (unsigned) streamStats.maxUs,
+                streamStats.lines ? (unsigned) (streamStats.totalUs / streamStats.lines) : 0u);
+  Serial.printf("stream opens: %u  ms: last %u  max %u  heap free after last open: %u\n",
+                (unsigned) streamOpenStats.opens, (unsigned) streamOpenStats.lastMs,
+                (unsigned) streamOpenStats.maxMs, (unsigned) streamOpenStats.heapAfterOpen);
+  Serial.printf("api session: %s  handshakes: %u (last %u ms, max %u ms)  failures: %u\n",
+                apiSessionOpen ? "open" : "closed", (unsigned) apiStats.handshakes,
+                (unsigned) apiStats.lastHandshakeMs, (unsigned) apiStats.maxHandshakeMs, (unsigned) apiStats.failures);
+  Serial.printf("api requests: %u (%u reused)  ms: last %u  max %u  mean %u\n",
+                (unsigned) apiStats.requests, (unsigned) apiStats.reused,
+                (unsigned) apiStats.lastRequestMs, (unsigned) apiStats.maxRequestMs,
+                apiStats.requests ? (unsigned) (apiStats.totalRequestMs / apiStats.requests) : 0u);
+  Serial.printf("pending moves: %u  queued %u  acked %u  retries %u  429s %u  dropped %u  ack ms: last %u  max %u  mean %u\n",
+                (unsigned) pendingCount, (unsigned) pendingStats.queued, (unsigned) pendingStats.acked,
+                (unsigned) pendingStats.retries, (unsigned) pendingStats.rateLimited, (unsigned) pendingStats.dropped,
+                (unsigned) pendingStats.lastAckMs, (unsigned) pendingStats.maxAckMs,
+                pendingStats.acked ? (unsigned) (pendingStats.totalAckMs / pendingStats.acked) : 0u);
+  Serial.printf("resync: checks %u  mismatches %u  fix moves %u  left to hand %u\n",
+                (unsigned) resyncStats.checks, (unsigned) resyncStats.mismatches,
+                (unsigned) resyncStats.fixMoves, (unsigned) resyncStats.manual);
+  printTaskStats("net", netTaskHandle, netTaskStats, outboundMoves.size());
+  printTaskStats("serial", serialTaskHandle, serialTaskStats, inboundMoves.size());
+}
+
+// Stack watermark is the least free stack (bytes) the task has had so far
+void printTaskStats(const char* name, TaskHandle_t h, const TaskStats& st, size_t queued) {
+  Serial.printf("task %s: stack free min %u  loops %u  loop us: last %u  max %u  queue wait max %u us  queued %u  dropped %u\n",
+                name, h ? (unsigned) uxTaskGetStackHighWaterMark(h) : 0u, (unsigned) st.loops,
+                (unsigned) st.lastLoopUs, (unsigned) st.maxLoopUs, (unsigned) st.maxQueueUs,
+                (unsigned) queued, (unsigned) st.queueFull);
+}
+
+// Send move to lichess
+// Returns the HTTP status code, -1 if there was no response
+int sendMoveToLichess(const char* gameId, const char* uci) {
+  if (!gameId[0] || !uci[0]) return -1;
+  char path[96];
+  snprintf(path, sizeof(path), "/api/board/game/%s/move/%s", gameId, uci);
+  int status = httpPostNoBody(path);
+  Serial.printf("POST move %s -> %d (%u ms)\n", uci, status, (unsigned) apiStats.lastRequestMs);
+  return status;
+}
+
+PendingMove& pendingAt(size_t i) {
+  return pendingMoves[(pendingHead + i) % PENDING_MAX];
+}
+
+void removePending(size_t i) {
+  for (; i + 1 < pendingCount; i++) pendingAt(i) = pendingAt(i + 1);
+  pendingCount--;
+}
+
+void queuePendingMove(const char* uci, bool fromAtmega, uint16_t seq) {
+  if (pendingCount == PENDING_MAX) {
+    Serial.printf("Pending move queue full, dropped: %s\n", uci);
+    pendingStats.dropped++;
+    return;
   }
-  else if (t == "gameState") {
-    const char* movesC = doc["moves"];
-    if (!movesC) return;
-    String movesStr = String(movesC); movesStr.trim();
-    if (movesStr.length() == 0) return;
-
-    // get latest move in UCI
-    int lastSpace = movesStr.lastIndexOf(' ');
-    String latestMove = (lastSpace == -1) ? movesStr : movesStr.substring(lastSpace + 1);
-    latestMove.trim();
-    if (latestMove.length() < 4) return; // sanity
-
-    // avoid duplicates
-    if (latestMove == lastProcessedMove) return;
-
-    // Determine move number index
-    int moveCount = 1;
-    for (int i = 0; i < movesStr.length(); i++) if (movesStr[i] == ' ') moveCount++;
-    bool isWhiteMove = (moveCount % 2 == 1); // white starts on move 1
-    bool isMyMove = ((isWhiteMove && myColor == "white") ||
-                     (!isWhiteMove && myColor == "black"));
-
-    // compute capture square by applying to our board
-    String captureSquare = applyUciMoveToBoard(latestMove);
-
-    // Prepare payload to ATmega:
-    String fromSq = latestMove.substring(0,2);
-    String toSq   = latestMove.substring(2,4);
-
-    // Detect castling by checking moved piece was a king and two-file move
-    bool isKing = false;
-    {
-      int fx = fileCharToX(fromSq[0]), fy = rankCharToY(fromSq[1]);
-      char pc = getBoardSquare(fx, fy);
-      isKing = (toupper(pc) == 'K');
+  PendingMove& pm = pendingAt(pendingCount++);
+  strlcpy(pm.uci, uci, sizeof(pm.uci));
+  strlcpy(pm.gameId, currentGameId, sizeof(pm.gameId));
+  pm.posted = false;
+  pm.fromAtmega = fromAtmega;
+  pm.seq = seq;
+  pm.attempts = 0;
+  pm.enqueuedMs = pm.nextAttemptMs = millis();
+  pendingStats.queued++;
+}
+
+// The game stream applied uci: if it is a move of ours still pending, it is done
+void ackPendingMove(const char* uci) {
+  bool isWhiteMove = (plyCount % 2 == 1);
+  if ((myColor == COLOR_WHITE && !isWhiteMove) || (myColor == COLOR_BLACK && isWhiteMove)) return;
+  for (size_t i = 0; i < pendingCount; i++) {
+    PendingMove& pm = pendingAt(i);
+    if (strcmp(pm.uci, uci) != 0 || strcmp(currentGameId, pm.gameId) != 0) continue;
+    uint32_t dt = millis() - pm.enqueuedMs;
+    pendingStats.acked++;
+    pendingStats.lastAckMs = dt;
+    pendingStats.totalAckMs += dt;
+    if (dt > pendingStats.maxAckMs) pendingStats.maxAckMs = dt;
+    traceMove(pm.seq, "e.ack");
+    removePending(i);
+    return;
+  }
+}
+
+// Post the oldest unposted move when its backoff has expired. One POST per call so the
+// streams keep being serviced between retries.
+void servicePendingMoves() {
+  unsigned long now = millis();
+  for (size_t i = 0; i < pendingCount; i++) {
+    PendingMove& pm = pendingAt(i);
+    if (strcmp(currentGameId, pm.gameId) != 0) {
+      Serial.printf("Dropping pending move %s: game %s is no longer active\n", pm.uci, pm.gameId);
+      pendingStats.dropped++;
+      removePending(i--);
+      continue;
     }
-    bool isCastle = isKing && abs(fileCharToX(toSq[0]) - fileCharToX(fromSq[0])) == 2;
-
-    String payload;
-
-        if (isCastle) {
-        // produce 4 coordinate pairs: king-from, king-to, rook-from, rook-to (8 chars)
-        if (toSq[0] == 'g') { 
-            // King-side castle (h -> f)
-            payload = fromSq + toSq + String("h") + String(fromSq[1]) + String("f") + String(fromSq[1]);
-        } else {
-            // Queen-side castle (a -> d)
-            payload = fromSq + toSq + String("a") + String(fromSq[1]) + String("d") + String(fromSq[1]);
-        }
-    } else if (captureSquare.length()) {
-        // Capture (normal or en-passant): from,to,capture
-        payload = fromSq + toSq + captureSquare;
-    } else {
-        // Normal move: from,to
-        payload = fromSq + toSq;
+    if (pm.posted && now - pm.postedMs > ACK_TIMEOUT_MS) {
+      Serial.printf("Pending move %s never showed on the stream, dropping\n", pm.uci);
+      pendingStats.dropped++;
+      removePending(i--);
     }
-    // update lastProcessedMove
-    lastProcessedMove = latestMove;
+  }
 
-    // Decide whether to send to ATmega: send unless it exactly matches lastMoveFromAtmega
-    if (payload == lastMoveFromAtmega) {
-      Serial.println((isMyMove ? "MY MOVE (suppressed send to ATmega): " : "OPPONENT MOVE (suppressed send to ATmega): ") + payload);
-    } else {
-      // send raw payload to ATmega (no prefixes)
-      Serial.println((isMyMove ? "MY MOVE detected: " : "OPPONENT MOVE detected: ") + latestMove + (captureSquare.length() ? ("  capture at " + captureSquare) : ""));
-      Serial.println(" -> send to ATmega: " + payload);
-      if (atmegaConnected) Serial2.println(payload);
-      else Serial.println("[ATmega not connected] would send: " + payload);
-    }
+  if (pendingCount == 0 || (long) (now - rateLimitedUntil) < 0) return;
+  size_t i = 0;
+  while (i < pendingCount && pendingAt(i).posted) i++;
+  if (i == pendingCount) return;
+  PendingMove& pm = pendingAt(i);
+  if ((long) (now - pm.nextAttemptMs) < 0) return;
+
+  if (pm.attempts) pendingStats.retries++;
+  pm.attempts++;
+  traceMove(pm.seq, "e.post");
+  int status = sendMoveToLichess(pm.gameId, pm.uci);
+  traceMove(pm.seq, "e.resp");
+  if (status >= 200 && status < 300) {
+    pm.posted = true;
+    pm.postedMs = millis();
+  } else if (status == 429) {
+    // rate limited: this attempt doesn't count, hold every POST until the window passes
+    pm.attempts--;
+    pendingStats.rateLimited++;
+    rateLimitedUntil = millis() + (apiRetryAfterS > 0 ? apiRetryAfterS * 1000UL : RATE_LIMIT_DEFAULT_MS);
+    Serial.printf("Rate limited, holding move posts for %lu ms\n", rateLimitedUntil - millis());
+  } else if ((status >= 400 && status < 500) || pm.attempts >= RETRY_MAX_ATTEMPTS) {
+    // illegal move / not our turn / game over won't get better by retrying
+    Serial.printf("Failed to post move from %s: %s (status %d, %u attempts)\n",
+                  pm.fromAtmega ? "ATmega" : "Serial", pm.uci, status, (unsigned) pm.attempts);
+    pendingStats.dropped++;
+    removePending(i);
+  } else {
+    unsigned long backoff = min(RETRY_BASE_MS << (pm.attempts - 1), RETRY_MAX_MS);
+    pm.nextAttemptMs = millis() + backoff;
+    Serial.printf("POST %s failed (%d), retry %u in %lu ms\n", pm.uci, status, (unsigned) pm.attempts, backoff);
+  }
+}
+
+// ---------- Board resync ----------
+bool pushInbound(const char* payload) {
+  InboundMove in;
+  strlcpy(in.payload, payload, sizeof(in.payload));
+  in.seq = 0;
+  in.queuedUs = micros();
+  if (inboundMoves.push(in)) return true;
+  netTaskStats.queueFull++;
+  return false;
+}
+
+// Ask for the ATmega's occupancy, tagged with the ply it should match. It is queued behind
+// any move payloads, so the answer comes once the gantry is through them.
+void requestOccupancy(unsigned long delayMs) {
+  nextOccupancyCheck = millis() + delayMs;
+  if (!atmegaConnected || !streaming || strcmp(currentGameId, streamGameId) != 0) return;
+  char cmd[INBOUND_MAX];
+  snprintf(cmd, sizeof(cmd), "occ %d", plyCount);
+  pushInbound(cmd);
+}
+
+void checkOccupancy(const OccupancyReply& r) {
+  // a move under way, a newer ply, or a local move the stream hasn't shown yet: the
+  // boards are expected to differ for now
+  if (r.state != 0 || r.ply != plyCount || pendingCount) return;
+  resyncStats.checks++;
+  if (resyncPly != plyCount) {
+    resyncPly = plyCount;
+    resyncAttempts = 0;
   }
-  else {
-    // ignore other types
+  uint64_t expected = cc_occupancy(&position_);
+  ResyncPlan plan;
+  if (!planResync(expected, r.occ, &plan)) {
+    mismatchOcc = 0;
+    return;
+  }
+  char extra[64], missing[64];
+  if (r.occ != mismatchOcc) {
+    squareListName(r.occ & ~expected, extra, sizeof(extra));
+    squareListName(expected & ~r.occ, missing, sizeof(missing));
+    Serial.printf("Board differs from the game at ply %d: extra [%s] missing [%s], checking again\n",
+                  plyCount, extra, missing);
+    mismatchOcc = r.occ;
+    nextOccupancyCheck = millis() + RESYNC_CONFIRM_MS;
     return;
   }
-}
 
-// Send move to lichess
-bool sendMoveToLichess(const String& gameId, const String& uci) {
-  if (gameId.length() == 0 || uci.length() == 0) return false;
-  String path = "/api/board/game/" + gameId + "/move/" + uci;
-  String status;
-  bool ok = httpPostNoBody("lichess.org", path, status);
-  Serial.println("POST move " + uci + " -> " + status);
-  return ok;
+  mismatchOcc = 0;
+  resyncStats.mismatches++;
+  if (resyncAttempts >= RESYNC_MAX_ATTEMPTS) {
+    // the fixes didn't take (piece knocked over, off-centre): stop moving things
+    plan.count = 0;
+    plan.extra = r.occ & ~expected;
+    plan.missing = expected & ~r.occ;
+  }
+  resyncAttempts++;
+  for (int i = 0; i < plan.count; i++) {
+    char cmd[INBOUND_MAX];
+    snprintf(cmd, sizeof(cmd), "fix %s", plan.moves[i]);
+    Serial.printf("Resync: %s\n", cmd);
+    if (pushInbound(cmd)) resyncStats.fixMoves++;
+  }
+  if (plan.extra || plan.missing) {
+    resyncStats.manual++;
+    squareListName(plan.extra, extra, sizeof(extra));
+    squareListName(plan.missing, missing, sizeof(missing));
+    Serial.printf("Resync: fix by hand: clear [%s] fill [%s]\n", extra, missing);
+  }
+  // check the result once the fixes are done
+  if (plan.count) requestOccupancy(RESYNC_INTERVAL_MS);
 }
 
-// normalize inputs like "e2e4", "e2 e4" into "e2e4"
-String normalizeATmegaMove(String s) {
-  String out = "";
-  for (char c : s) {
-    if (c == ' ' || c == '-' || c == ',') continue;
-    out += c;
+// Called from the net task loop
+void serviceResync() {
+  OccupancyReply r;
+  while (occupancyReplies.pop(r)) checkOccupancy(r);
+  if (occupancyCheckDue || (long) (millis() - nextOccupancyCheck) >= 0) {
+    occupancyCheckDue = false;
+    requestOccupancy(RESYNC_INTERVAL_MS);
   }
-  out.toLowerCase();
-  if (out.length() == 4 || out.length() == 5) return out; // uci (4) or promotion (5)
-  return "";
 }
 
 void setup() {
@@ -476,86 +950,310 @@ void setup() {
   delay(100);
 
   // store our lichess user (lowercased) for later color detection
-  myLichessId = String(LICHESS_USER);
-  myLichessId.toLowerCase();
+  setMyLichessId(LICHESS_USER);
 
   Serial2.begin(SERIAL2_BAUD, SERIAL_8N1, SERIAL2_RX, SERIAL2_TX);
   delay(100);
 
-  initBoardFromFEN();
-  connectWiFi();
+  buildStreamFilter();
+  resetMoveTracking();
+
+  // a game followed before the reboot resumes at its checkpoint when its gameFull arrives
+  prefs.begin("bridge", false);
+  BridgeCheckpoint cp;
+  if (prefs.getBytes(CHECKPOINT_KEY, &cp, sizeof(cp)) == sizeof(cp) && cp.magic == CHECKPOINT_MAGIC) {
+    Serial.printf("Checkpoint: game %s, ply %d\n", cp.gameId, (int) cp.plyCount);
+    setResumeCheckpoint(&cp);
+  }
   lastPlayingFetch = 0;
+
+  xTaskCreatePinnedToCore(netTask, "net", NET_TASK_STACK, nullptr, 1, &netTaskHandle, NET_TASK_CORE);
+  xTaskCreatePinnedToCore(serialTask, "serial", SERIAL_TASK_STACK, nullptr, 2, &serialTaskHandle, SERIAL_TASK_CORE);
 }
 
+// Everything runs in netTask / serialTask
 void loop() {
-  // Periodically fetch playing games
-  if (millis() - lastPlayingFetch > PLAYING_FETCH_INTERVAL) {
-    lastPlayingFetch = millis();
-    if (!streaming) fetchPlayingGames();
+  vTaskDelete(NULL);
+}
+
+void noteLoop(TaskStats& st, uint32_t startUs) {
+  uint32_t dt = micros() - startUs;
+  st.loops++;
+  st.lastLoopUs = dt;
+  if (dt > st.maxLoopUs) st.maxLoopUs = dt;
+}
+
+// ---------- Network task (core 0): WiFi, API session, event + game streams ----------
+// Owns position_, the stream state and lastMoveFromAtmega; blocking network calls only stall this task.
+void netTask(void*) {
+  for (;;) {
+    uint32_t t0 = micros();
+    if (WiFi.status() != WL_CONNECTED) connectWiFi();
+
+    // Local moves from the serial task: record for echo suppression, post UCI moves
+    OutboundMove out;
+    while (outboundMoves.pop(out)) {
+      uint32_t waited = micros() - out.queuedUs;
+      if (waited > netTaskStats.maxQueueUs) netTaskStats.maxQueueUs = waited;
+      if (!out.post) {
+        // ATmega sent capture-triple or castling payload already (6 or 8 chars) — don't post to lichess
+        memcpy(lastMoveFromAtmega, out.text, sizeof(lastMoveFromAtmega)); // store exact payload so stream suppression works
+        continue;
+      }
+      // Build the payload form we expect to later send to ATmega (so suppression will match)
+      buildPayloadForUciSimple(out.text, lastMoveFromAtmega);
+      queuePendingMove(out.text, out.fromAtmega, out.seq);
+    }
+    servicePendingMoves();
+
+    apiSessionService();
+
+    // Account events: new games are picked up as soon as lichess announces them
+    if (eventStreaming) {
+      size_t len;
+      while ((len = eventStream.readLine(eventClient)) > 0) handleEventLine(eventStream.line, len);
+      if (!eventClient.connected() || millis() - eventStream.lastByteMs > STREAM_SILENCE_TIMEOUT_MS) {
+        Serial.println("Event stream dropped, falling back to polling.");
+        eventClient.stop();
+        eventStreaming = false;
+        eventReconnectDelay = EVENT_RECONNECT_MIN_MS;
+      }
+    } else if (WiFi.status() == WL_CONNECTED && millis() - lastEventConnectAttempt > eventReconnectDelay) {
+      startEventStream();
+    }
+
+    // Fall back to polling for games only while the event stream is down
+    if (!eventStreaming && millis() - lastPlayingFetch > PLAYING_FETCH_INTERVAL) {
+      lastPlayingFetch = millis();
+      if (!streaming) fetchPlayingGames();
+    }
+
+    // Stream handling
+    if (streaming && streamClient.connected()) {
+      size_t len;
+      while ((len = gameStream.readLine(streamClient)) > 0) handleStreamLine(gameStream.line, len);
+      serviceResync();
+    } else {
+      if (streaming && !streamClient.connected()) {
+        Serial.println("Stream disconnected.");
+        streaming = false;
+        currentGameId[0] = '\0';
+      }
+    }
+
+    noteLoop(netTaskStats, t0);
+    vTaskDelay(pdMS_TO_TICKS(2));
   }
+}
 
-  // Stream handling
-  if (streaming && streamClient.connected()) {
-    if (streamClient.available()) {
-      String line = readStreamLine();
-      if (line.length() > 0) handleStreamLine(line);
+// ---------- Serial task (core 1): Serial Monitor + ATmega link ----------
+// Returns true when a complete, trimmed, non-empty line is in lb.buf
+bool pollSerialLine(HardwareSerial& port, SerialLine& lb) {
+  while (port.available()) {
+    char c = (char) port.read();
+    if (c == '\n' || c == '\r') {
+      if (lb.len == 0) continue;
+      lb.buf[lb.len] = '\0';
+      lb.len = 0;
+      // trim in place
+      char* start = lb.buf;
+      while (isspace((unsigned char) *start)) start++;
+      size_t n = strlen(start);
+      while (n && isspace((unsigned char) start[n - 1])) n--;
+      if (n == 0) continue;
+      memmove(lb.buf, start, n);
+      lb.buf[n] = '\0';
+      return true;
     }
-  } else {
-    if (streaming && !streamClient.connected()) {
-      Serial.println("Stream disconnected.");
-      streaming = false;
-      currentGameId = "";
+    if (lb.len + 1 < sizeof(lb.buf)) lb.buf[lb.len++] = c;
+  }
+  return false;
+}
+
+void queueOutbound(const char* text, bool post, bool fromAtmega, uint16_t seq) {
+  OutboundMove out;
+  strlcpy(out.text, text, sizeof(out.text));
+  out.post = post;
+  out.fromAtmega = fromAtmega;
+  out.seq = seq;
+  out.queuedUs = micros();
+  if (!outboundMoves.push(out)) {
+    serialTaskStats.queueFull++;
+    Serial.printf("Outbound queue full, dropped: %s\n", text);
+  }
+}
+
+// ---------- Hardware replay ----------
+// Moves of one Serial Monitor line, checked against the position and turned into payloads
+void replayLoad(const char* line) {
+  char tok[16];
+  while ((line = cc_next_move_token(line, tok, sizeof(tok))) != nullptr) {
+    cc_move_t mv;
+    if (replay.count == REPLAY_MAX_MOVES) {
+      Serial.printf("Replay: more than %u moves, the rest is left out\n", (unsigned) REPLAY_MAX_MOVES);
+      return;
+    }
+    if (!cc_parse_move(&replay.pos, tok, &mv)) {
+      Serial.printf("Replay: can't play %s as move %u, rest of the line left out\n", tok, (unsigned) replay.count + 1);
+      return;
     }
+    cc_apply(&replay.pos, &mv);
+    buildPayloadForStreamMove(&mv, replay.payloads[replay.count++]);
   }
+}
 
-  // Read from Serial Monitor (USB) and treat as ATmega input
-  while (Serial.available()) {
-    String raw = Serial.readStringUntil('\n');
-    raw.trim();
-    if (raw.length() == 0) continue;
-    if (raw.startsWith("ack:") || raw.startsWith("my:") || raw.startsWith("op:")) continue;
+void replaySendNext() {
+  if (replay.next < replay.count) Serial2.printf("rp %s\n", replay.payloads[replay.next++]);
+  else Serial2.println("replay end");
+}
 
-    String uci = normalizeATmegaMove(raw);
-    if (uci.length() < 4) {
-      Serial.println("Invalid move from Serial Monitor: " + raw);
-      continue;
+// "rp:" answers from the ATmega
+void handleReplayLine(const char* line) {
+  unsigned n, ms, failed, off, moves;
+  unsigned long total, maxMs;
+  char payload[PAYLOAD_MAX];
+  if (strcmp(line, "rp:start") == 0) {
+    replay.startMs = millis();
+    replaySendNext();
+  } else if (strncmp(line, "rp:error", 8) == 0) {
+    Serial.printf("Replay: %s\n", line + 3);
+    replay.running = false;
+  } else if (sscanf(line, "rp:done %u %lu %lu %u %u", &moves, &total, &maxMs, &failed, &off) == 5) {
+    unsigned long wall = millis() - replay.startMs;
+    replay.running = false;
+    if (!moves || !total) {
+      Serial.println("Replay: no moves played");
+      return;
     }
+    Serial.printf("replay: %u moves, board time %.1f s, mean %lu ms, max %lu ms, %.2f moves/min\n",
+                  moves, total / 1000.0, total / moves, maxMs, moves * 60000.0 / total);
+    Serial.printf("replay: %.2f moves/min over the link (%.1f s wall), %u failed placements, %u moves with squares off\n",
+                  moves * 60000.0 / wall, wall / 1000.0, failed, off);
+  } else if (replay.running && sscanf(line, "rp:%u %8s %u %u %u", &n, payload, &ms, &failed, &off) == 5) {
+    Serial.printf("move %u: %s %u ms%s", n, payload, ms, failed || off ? "" : "\n");
+    if (failed || off) Serial.printf("  %u failed placements, %u squares off\n", failed, off);
+    replaySendNext();
+  }
+}
 
-    // Build the payload form we expect to later send to ATmega (so suppression will match)
-    String candidatePayload = buildPayloadForUciSimple(uci);
-    lastMoveFromAtmega = candidatePayload;
-    Serial.println("Local move (Serial Monitor) -> post to Lichess: " + uci + "  payloadRecorded: " + candidatePayload);
-
-    bool ok = sendMoveToLichess(currentGameId, uci);
-    if (!ok) Serial.println("Failed to post move from Serial.");
-  }
-
-  // Read from Serial2 (ATmega) and treat input as local move or capture triple
-  if (atmegaConnected) {
-    while (Serial2.available()) {
-      String raw = Serial2.readStringUntil('\n');
-      raw.trim();
-      if (raw.length() == 0) continue;
-      if (raw.startsWith("ack:") || raw.startsWith("my:") || raw.startsWith("op:")) continue;
-
-      String uciCandidate = normalizeATmegaMove(raw);
-
-      // If ATmega sends a UCI (4/5 chars), post to lichess and remember payload in expected format
-      if (uciCandidate.length() == 4 || uciCandidate.length() == 5) {
-        // Prepare payload form for suppression (non-capture)
-        String candidatePayload = buildPayloadForUciSimple(uciCandidate);
-        lastMoveFromAtmega = candidatePayload;
-        Serial.println("Local move (Serial2) -> post to Lichess: " + uciCandidate + "  payloadRecorded: " + candidatePayload);
-        bool ok = sendMoveToLichess(currentGameId, uciCandidate);
-        if (!ok) Serial.println("Failed to post move from ATmega.");
-      } else {
-        // ATmega sent capture-triple or castling payload already (6 or 8 chars) — don't post to lichess
-        lastMoveFromAtmega = raw; // store exact payload so stream suppression works
-        Serial.println("ATmega sent (raw payload): " + raw + " (not posted to Lichess)");
+// Serial Monitor lines while a replay is being loaded or run; false if not ours
+bool handleReplayCommand(const char* line) {
+  if (replay.loading) {
+    if (strcmp(line, "go") == 0) {
+      replay.loading = false;
+      if (!replay.count) {
+        Serial.println("Replay: no moves");
+        return true;
       }
+      Serial.printf("Replay: %u moves, starting\n", (unsigned) replay.count);
+      replay.running = true;
+      replay.next = 0;
+      if (atmegaConnected) Serial2.println("replay");
+    } else if (strcmp(line, "cancel") == 0) {
+      replay.loading = false;
+      Serial.println("Replay cancelled");
+    } else {
+      replayLoad(line);
     }
+    return true;
   }
+  if (strcmp(line, "replay stop") == 0) {
+    // the move under way finishes, then "replay end" goes out instead of the next one
+    if (replay.running) replay.count = replay.next;
+    return true;
+  }
+  if (strcmp(line, "replay") != 0) return false;
+  if (streaming || replay.running) {
+    Serial.println("Replay: not while a game or another replay is on");
+    return true;
+  }
+  cc_position_start(&replay.pos);
+  replay.count = 0;
+  replay.loading = true;
+  Serial.println("Replay: paste a PGN or UCI move list (from the initial position), then \"go\"; \"cancel\" to drop it");
+  return true;
+}
 
-  delay(10);
+// One line from the Serial Monitor (fromAtmega false) or Serial2 (true)
+void handleLocalLine(char* line, bool fromAtmega) {
+  if (fromAtmega && strncmp(line, "tr:", 3) == 0) {
+    forwardAtmegaTrace(line);
+    return;
+  }
+  if (fromAtmega && (strncmp(line, "pf:", 3) == 0 || strncmp(line, "mem:", 4) == 0 ||
+                     strncmp(line, "rc:", 3) == 0)) {
+    // ATmega region profile / SRAM use / sensor recording, answers to "prof", "mem" and "rec"
+    Serial.println(line);
+    return;
+  }
+  if (fromAtmega && strncmp(line, "rp:", 3) == 0) {
+    handleReplayLine(line);
+    return;
+  }
+  if (!fromAtmega && handleReplayCommand(line)) return;
+  if (fromAtmega && strncmp(line, "oc:", 3) == 0) {
+    // occupancy for the resync check, which the net task owns
+    OccupancyReply r;
+    if (parseOccupancyReply(line, &r.ply, &r.occ, &r.state) && !occupancyReplies.push(r)) serialTaskStats.queueFull++;
+    return;
+  }
+  uint16_t seq = splitMoveSeq(line);
+  traceMove(seq, "e.rx");
+  if (strncmp(line, "ack:", 4) == 0 || strncmp(line, "my:", 3) == 0 || strncmp(line, "op:", 3) == 0) return;
+  if (!fromAtmega && strcmp(line, "stats") == 0) {
+    printBridgeStats();
+    return;
+  }
+  if (!fromAtmega && (strcmp(line, "reset") == 0 || strcmp(line, "calibrate") == 0 || strcmp(line, "prof") == 0 ||
+                      strcmp(line, "mem") == 0 || strcmp(line, "rec") == 0 || strcmp(line, "rec clear") == 0)) {
+    // board reset / axis calibration (empty board) / ATmega profile, SRAM use or sensor
+    // recording on demand; the net task sends a reset itself when a game finishes
+    if (atmegaConnected) Serial2.println(line);
+    return;
+  }
+
+  char uci[6];
+
+  // If ATmega sends a UCI (4/5 chars), post to lichess and remember payload in expected format
+  if (normalizeATmegaMove(line, uci)) {
+    Serial.printf("Local move (%s) -> post to Lichess: %s\n", fromAtmega ? "Serial2" : "Serial Monitor", uci);
+    queueOutbound(uci, true, fromAtmega, seq);
+  } else if (fromAtmega) {
+    // capture-triple or castling payload (6 or 8 chars): record only
+    Serial.printf("ATmega sent (raw payload): %s (not posted to Lichess)\n", line);
+    queueOutbound(line, false, true, seq);
+  } else {
+    Serial.printf("Invalid move from Serial Monitor: %s\n", line);
+  }
 }
 
+void serialTask(void*) {
+  for (;;) {
+    uint32_t t0 = micros();
+
+    // Opponent / streamed moves from the net task go straight out to the ATmega
+    InboundMove in;
+    while (inboundMoves.pop(in)) {
+      uint32_t waited = micros() - in.queuedUs;
+      if (waited > serialTaskStats.maxQueueUs) serialTaskStats.maxQueueUs = waited;
+      if (atmegaConnected) {
+#if MOVE_TRACE
+        if (in.seq) Serial2.printf("%s#%u\n", in.payload, (unsigned) in.seq);
+        else Serial2.println(in.payload);
+#else
+        Serial2.println(in.payload);
+#endif
+        traceMove(in.seq, "e.tx");
+      } else Serial.printf("[ATmega not connected] would send: %s\n", in.payload);
+    }
+
+    // Read from Serial Monitor (USB) and treat as ATmega input
+    if (pollSerialLine(Serial, monitorLine)) handleLocalLine(monitorLine.buf, false);
+
+    // Read from Serial2 (ATmega) and treat input as local move or capture triple
+    if (atmegaConnected && pollSerialLine(Serial2, atmegaLine)) handleLocalLine(atmegaLine.buf, true);
+
+    noteLoop(serialTaskStats, t0);
+    vTaskDelay(pdMS_TO_TICKS(2));
+  }
+}
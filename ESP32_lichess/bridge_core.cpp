@@ -0,0 +1,455 @@
+#include "bridge_core.h"
+#include <ArduinoJson.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+PlayerColor myColor = COLOR_NONE;
+char myLichessId[32] = "";
+char lastProcessedMove[6] = "";
+
+int plyCount = 0;
+size_t movesOffset = 0;
+
+char lastMoveFromAtmega[PAYLOAD_MAX] = "";
+
+cc_position_t position_;
+char streamGameId[16] = "";
+
+// checkpoint from before a reboot, used by the first gameFull of that game
+static BridgeCheckpoint resumeCheckpoint;
+static bool resumePending = false;
+
+StreamStats streamStats;
+
+// Only these fields are kept when a stream line is parsed, so the document stays small
+StaticJsonDocument<256> streamFilter;
+const size_t STREAM_DOC_SIZE = 512;
+StaticJsonDocument<128> eventFilter;
+const size_t EVENT_DOC_SIZE = 256;
+
+// ---------- Board ----------
+// Forget all applied moves and go back to the start position
+void resetMoveTracking() {
+  cc_position_start(&position_);
+  plyCount = 0;
+  movesOffset = 0;
+  lastProcessedMove[0] = '\0';
+}
+
+// Apply a UCI move to position_ and classify it (capture square, castling rook) in mv.
+// Returns false, leaving position_ untouched, if there is no piece on the from square.
+bool applyUciMoveToBoard(const char* uci, cc_move_t* mv) {
+  if (cc_apply_uci(&position_, uci, mv)) return true;
+  bridgeLog("Tracked board has no piece for %s\n", uci);
+  return false;
+}
+
+// Snapshot of the tracking state for bridgeSaveCheckpoint()
+void fillCheckpoint(BridgeCheckpoint* cp) {
+  memset(cp, 0, sizeof(*cp));
+  cp->magic = CHECKPOINT_MAGIC;
+  strncpy(cp->gameId, streamGameId, sizeof(cp->gameId) - 1);
+  cp->position = position_;
+  cp->plyCount = plyCount;
+  cp->movesOffset = (uint32_t) movesOffset;
+  memcpy(cp->lastProcessedMove, lastProcessedMove, sizeof(cp->lastProcessedMove));
+}
+
+void setResumeCheckpoint(const BridgeCheckpoint* cp) {
+  if (cp->magic != CHECKPOINT_MAGIC || !cp->gameId[0]) return;
+  resumeCheckpoint = *cp;
+  resumeCheckpoint.gameId[sizeof(resumeCheckpoint.gameId) - 1] = '\0';
+  resumeCheckpoint.lastProcessedMove[sizeof(resumeCheckpoint.lastProcessedMove) - 1] = '\0';
+  resumePending = true;
+}
+
+// Continue from the saved checkpoint if it belongs to this game and its moves are still a
+// prefix of the list; then only the tail is applied
+static bool resumeFromCheckpoint(const char* moves, size_t len) {
+  if (!resumePending) return false;
+  resumePending = false;
+  if (strcmp(resumeCheckpoint.gameId, streamGameId) != 0) return false;
+  position_ = resumeCheckpoint.position;
+  plyCount = resumeCheckpoint.plyCount;
+  movesOffset = resumeCheckpoint.movesOffset;
+  memcpy(lastProcessedMove, resumeCheckpoint.lastProcessedMove, sizeof(lastProcessedMove));
+  if (!movesPrefixMatches(moves, len)) {
+    bridgeLog("Checkpoint for %s no longer matches the move list\n", streamGameId);
+    return false;
+  }
+  bridgeLog("Resumed %s at ply %d from checkpoint\n", streamGameId, plyCount);
+  return true;
+}
+
+static void saveCheckpoint() {
+  BridgeCheckpoint cp;
+  fillCheckpoint(&cp);
+  bridgeSaveCheckpoint(cp);
+}
+
+// ---------- Payloads ----------
+// Build the "payload" that we send to ATmega for a simple UCI (non-capture) move
+void buildPayloadForUciSimple(const char* uci, char out[PAYLOAD_MAX]) {
+  out[0] = '\0';
+  if (strlen(uci) < 4) return;
+  memcpy(out, uci, 4); // e2e4
+  out[4] = '\0';
+}
+
+// Build the payload for a streamed move as classified by applyUciMoveToBoard().
+// Normal: e2e4, capture: e5d6d5 (en passant: the captured pawn's square), castle: e1g1h1f1
+void buildPayloadForStreamMove(const cc_move_t* mv, char out[PAYLOAD_MAX]) {
+  cc_square_name(mv->from, out);
+  cc_square_name(mv->to, out + 2);
+  if (mv->flags & CC_MOVE_CASTLE) {
+    cc_square_name(mv->rook_from, out + 4);
+    cc_square_name(mv->rook_to, out + 6);
+  } else if (mv->flags & CC_MOVE_CAPTURE) {
+    cc_square_name(mv->capture_sq, out + 4);
+  }
+}
+
+// normalize inputs like "e2e4", "e2 e4" into "e2e4"; false unless the result is uci (4) or promotion (5)
+bool normalizeATmegaMove(const char* in, char out[6]) {
+  size_t n = 0;
+  for (const char* c = in; *c; c++) {
+    if (*c == ' ' || *c == '-' || *c == ',') continue;
+    if (n == 5) { n = 0; break; } // too long
+    out[n++] = (char)tolower((unsigned char)*c);
+  }
+  out[n] = '\0';
+  if (n == 4 || n == 5) return true;
+  out[0] = '\0';
+  return false;
+}
+
+// Strip a "#n" move sequence suffix (see MOVE_TRACE in the sketch); returns n, 0 if none
+uint16_t splitMoveSeq(char* line) {
+  char* hash = strchr(line, '#');
+  if (!hash) return 0;
+  *hash = '\0';
+  return (uint16_t)strtoul(hash + 1, nullptr, 10);
+}
+
+// ---------- Streams ----------
+void setMyLichessId(const char* id) {
+  size_t i = 0;
+  for (; id[i] && i + 1 < sizeof(myLichessId); i++) myLichessId[i] = (char)tolower((unsigned char)id[i]);
+  myLichessId[i] = '\0';
+}
+
+void buildStreamFilter() {
+  streamFilter.clear();
+  streamFilter["type"] = true;
+  streamFilter["id"] = true;
+  streamFilter["moves"] = true;
+  streamFilter["state"]["moves"] = true;
+  streamFilter["white"]["id"] = true;
+  streamFilter["white"]["user"]["name"] = true;
+  streamFilter["black"]["id"] = true;
+  streamFilter["black"]["user"]["name"] = true;
+
+  eventFilter.clear();
+  eventFilter["type"] = true;
+  eventFilter["game"]["gameId"] = true;
+  eventFilter["game"]["id"] = true;
+}
+
+// Copy the player id (or user name) from a gameFull side object, lowercased
+static void copyPlayerId(JsonVariant side, char* out, size_t outSize) {
+  const char* id = side["id"];
+  if (!id) id = side["user"]["name"];
+  if (!id) id = "";
+  size_t i = 0;
+  for (; id[i] && i + 1 < outSize; i++) out[i] = (char)tolower((unsigned char)id[i]);
+  out[i] = '\0';
+}
+
+const char* colorName(PlayerColor c) {
+  return c == COLOR_WHITE ? "white" : (c == COLOR_BLACK ? "black" : "");
+}
+
+// Hand a move that was just applied to position_ (plyCount includes it) to bridgeOnStreamMove().
+// New moves are sent to the ATmega unless the payload is the echo of our own move.
+static void reportStreamMove(const char* uci, const cc_move_t* applied, bool emit, bool lastInList) {
+  bool isWhiteMove = (plyCount % 2 == 1); // white starts on ply 1
+  char payload[PAYLOAD_MAX];
+  char captureSq[3] = "";
+  if (applied) {
+    buildPayloadForStreamMove(applied, payload);
+    if (applied->flags & CC_MOVE_CAPTURE) cc_square_name(applied->capture_sq, captureSq);
+  } else {
+    buildPayloadForUciSimple(uci, payload);
+  }
+
+  BridgeMove mv;
+  mv.uci = uci;
+  mv.captureSq = captureSq;
+  mv.payload = payload;
+  mv.ply = plyCount;
+  mv.isMyMove = ((isWhiteMove && myColor == COLOR_WHITE) ||
+                 (!isWhiteMove && myColor == COLOR_BLACK));
+  mv.emit = emit;
+  // Decide whether to send to ATmega: send unless it exactly matches lastMoveFromAtmega
+  mv.suppressed = (strcmp(payload, lastMoveFromAtmega) == 0);
+  mv.lastInList = lastInList;
+  if (emit) streamStats.moves++;
+  bridgeOnStreamMove(mv);
+}
+
+// Apply every move in moves[movesOffset..len) to position_, advancing plyCount/movesOffset.
+// Every applied move is passed to bridgeOnStreamMove(); emit marks them as new.
+void applyMovesTail(const char* moves, size_t len, bool emit) {
+  char m[6];
+  cc_move_t mv;
+  size_t p = movesOffset;
+  while (p < len) {
+    while (p < len && moves[p] == ' ') p++;
+    size_t n = 0;
+    while (p + n < len && moves[p + n] != ' ') n++;
+    if (n >= 4 && n <= 5) {
+      memcpy(m, moves + p, n);
+      m[n] = '\0';
+      bool applied = applyUciMoveToBoard(m, &mv);
+      plyCount++;
+      memcpy(lastProcessedMove, m, n + 1);
+      movesOffset = p + n;
+      reportStreamMove(m, applied ? &mv : nullptr, emit, p + n >= len);
+    }
+    p += n;
+  }
+}
+
+// True if the already-processed prefix of moves is still the one we applied:
+// the list did not shrink and lastProcessedMove still ends exactly at movesOffset.
+bool movesPrefixMatches(const char* moves, size_t len) {
+  if (len < movesOffset) return false;
+  if (movesOffset == 0) return true;
+  size_t lastLen = strlen(lastProcessedMove);
+  if (lastLen == 0 || movesOffset < lastLen) return false;
+  if (memcmp(moves + movesOffset - lastLen, lastProcessedMove, lastLen) != 0) return false;
+  return movesOffset == len || moves[movesOffset] == ' ';
+}
+
+// Process NDJSON stream lines; update board and send to ATmega (raw) unless suppressed.
+// line is parsed in place and is modified.
+void handleStreamLine(char* line, size_t len) {
+  if (len < 5 || line[0] != '{') return;
+  uint32_t t0 = bridgeMicros();
+
+  StaticJsonDocument<STREAM_DOC_SIZE> doc;
+  DeserializationError err = deserializeJson(doc, line, len, DeserializationOption::Filter(streamFilter));
+  if (err) {
+    streamStats.parseErrors++;
+    return;
+  }
+
+  const char* type = doc["type"];
+  if (!type) return;
+
+  if (strcmp(type, "gameFull") == 0) {
+    // Determine white/black user ids (lowercase comparison to avoid case mismatch)
+    char whiteUserId[32];
+    char blackUserId[32];
+    copyPlayerId(doc["white"], whiteUserId, sizeof(whiteUserId));
+    copyPlayerId(doc["black"], blackUserId, sizeof(blackUserId));
+
+    if (strcmp(myLichessId, whiteUserId) == 0) myColor = COLOR_WHITE;
+    else if (strcmp(myLichessId, blackUserId) == 0) myColor = COLOR_BLACK;
+    else myColor = COLOR_NONE;
+
+    bridgeLog("White user: %s\n", whiteUserId);
+    bridgeLog("Black user: %s\n", blackUserId);
+    bridgeLog("Me (API id): %s\n", myLichessId);
+    bridgeLog("Detected color: %s\n", colorName(myColor));
+
+    const char* id = doc["id"];
+    strncpy(streamGameId, id ? id : "", sizeof(streamGameId) - 1);
+    streamGameId[sizeof(streamGameId) - 1] = '\0';
+
+    // Reconstruct the board from "state.moves", starting at the checkpoint if there is one
+    const char* moves = doc["state"]["moves"];
+    if (!moves) moves = "";
+    size_t len = strlen(moves);
+    if (!resumeFromCheckpoint(moves, len)) resetMoveTracking();
+    applyMovesTail(moves, len, false);
+    saveCheckpoint();
+  }
+  else if (strcmp(type, "gameState") == 0) {
+    const char* moves = doc["moves"];
+    if (!moves) return;
+    size_t len = strlen(moves);
+
+    if (!movesPrefixMatches(moves, len)) {
+      // takeback or a list we never saw the start of: rebuild from scratch, don't replay to the ATmega
+      bridgeLog("Move list desync (ply %d, offset %u, list %u bytes) - resyncing board\n",
+                    plyCount, (unsigned) movesOffset, (unsigned) len);
+      resetMoveTracking();
+      applyMovesTail(moves, len, false);
+    } else {
+      // avoid duplicates: only the tail past movesOffset is new
+      if (len == movesOffset) return;
+      applyMovesTail(moves, len, true);
+    }
+    saveCheckpoint();
+  }
+  else {
+    // ignore other types
+    return;
+  }
+
+  uint32_t dt = bridgeMicros() - t0;
+  streamStats.lines++;
+  streamStats.lastUs = dt;
+  streamStats.totalUs += dt;
+  if (dt > streamStats.maxUs) streamStats.maxUs = dt;
+}
+
+// Pull type and game id out of an account event (gameStart / gameFinish). The returned
+// strings point into line, which is parsed in place.
+bool parseEventLine(char* line, size_t len, const char** type, const char** gameId) {
+  if (len < 5 || line[0] != '{') return false;
+
+  StaticJsonDocument<EVENT_DOC_SIZE> doc;
+  DeserializationError err = deserializeJson(doc, line, len, DeserializationOption::Filter(eventFilter));
+  if (err) return false;
+
+  *type = doc["type"];
+  *gameId = doc["game"]["gameId"];
+  if (!*gameId) *gameId = doc["game"]["id"];
+  return *type && *gameId;
+}
+
+// Parse /api/account/playing JSON and copy the first game id to out
+bool parsePlayingForGameId(const char* json, char* out, size_t outSize) {
+  out[0] = '\0';
+  StaticJsonDocument<2048> doc;
+  DeserializationError err = deserializeJson(doc, json);
+  if (err) {
+    bridgeLog("parsePlayingForGameId JSON error: %s\n", err.c_str());
+    return false;
+  }
+  JsonArray arr = doc["nowPlaying"].as<JsonArray>();
+  for (JsonVariant v : arr) {
+    const char* id = v["id"];
+    if (!id) id = v["gameId"];
+    if (!id) continue;
+    strncpy(out, id, outSize - 1);
+    out[outSize - 1] = '\0';
+    return true;
+  }
+  return false;
+}
+
+// ---------- Resync ----------
+// "oc:<ply> <hex> <state>" from the ATmega; false if the line is malformed
+bool parseOccupancyReply(const char* line, int* ply, uint64_t* occ, int* state) {
+  if (strncmp(line, "oc:", 3) != 0) return false;
+  char* end;
+  long p = strtol(line + 3, &end, 10);
+  if (end == line + 3 || *end != ' ') return false;
+  const char* hex = end + 1;
+  uint64_t bits = 0;
+  for (int file = 0; file < 8; file++) {
+    // one digit at a time: a truncated line ends at the first, don't read past it
+    if (!isxdigit((unsigned char)hex[2 * file]) || !isxdigit((unsigned char)hex[2 * file + 1])) return false;
+    char byteStr[3] = {hex[2 * file], hex[2 * file + 1], '\0'};
+    bits |= (uint64_t)strtoul(byteStr, nullptr, 16) << (8 * file);
+  }
+  if (hex[16] != ' ') return false;
+  *ply = (int)p;
+  *occ = bits;
+  *state = atoi(hex + 17);
+  return true;
+}
+
+static int squareDistance(uint8_t a, uint8_t b) {
+  int df = (a >> 3) - (b >> 3);
+  int dr = (a & 7) - (b & 7);
+  return (df < 0 ? -df : df) + (dr < 0 ? -dr : dr);
+}
+
+static int countSquares(uint64_t squares) {
+  int n = 0;
+  for (; squares; squares &= squares - 1) n++;
+  return n;
+}
+
+static void listSquares(uint64_t squares, uint8_t* out) {
+  for (uint8_t sq = 0; sq < 64; sq++) {
+    if ((squares >> sq) & 1) *out++ = sq;
+  }
+}
+
+// Cheapest assignment of each of the first n squares in a to a distinct square of b
+// (at most RESYNC_MAX_MOVES each side, so trying every assignment is cheap)
+static void bestPairing(const uint8_t* a, int n, const uint8_t* b, int m, int i, bool* used,
+                        int* pick, int cost, int* best, int* bestPick) {
+  if (cost >= *best) return;
+  if (i == n) {
+    *best = cost;
+    memcpy(bestPick, pick, n * sizeof(int));
+    return;
+  }
+  for (int j = 0; j < m; j++) {
+    if (used[j]) continue;
+    used[j] = true;
+    pick[i] = j;
+    bestPairing(a, n, b, m, i + 1, used, pick, cost + squareDistance(a[i], b[j]), best, bestPick);
+    used[j] = false;
+  }
+}
+
+// Fewest gantry moves that bring actual to expected: each extra piece is moved to a missing
+// square, paired so the total travel is shortest. Occupancy says nothing about which piece
+// stands where, so with several pairs the pairing is a best guess. What is left over, or
+// everything when there are more than RESYNC_MAX_MOVES differences either way, goes to
+// plan->extra / plan->missing for a hand to fix. Returns false if the boards agree.
+bool planResync(uint64_t expected, uint64_t actual, ResyncPlan* plan) {
+  memset(plan, 0, sizeof(*plan));
+  plan->extra = actual & ~expected;
+  plan->missing = expected & ~actual;
+  if (!plan->extra && !plan->missing) return false;
+
+  int ne = countSquares(plan->extra);
+  int nm = countSquares(plan->missing);
+  if (ne > RESYNC_MAX_MOVES || nm > RESYNC_MAX_MOVES || !ne || !nm) return true;
+  uint8_t extra[RESYNC_MAX_MOVES], missing[RESYNC_MAX_MOVES];
+  listSquares(plan->extra, extra);
+  listSquares(plan->missing, missing);
+
+  // pair from the smaller side
+  bool fromExtra = ne <= nm;
+  const uint8_t* a = fromExtra ? extra : missing;
+  const uint8_t* b = fromExtra ? missing : extra;
+  int n = fromExtra ? ne : nm;
+  int m = fromExtra ? nm : ne;
+  bool used[RESYNC_MAX_MOVES] = {false};
+  int pick[RESYNC_MAX_MOVES], bestPick[RESYNC_MAX_MOVES];
+  int best = 1 << 30;
+  bestPairing(a, n, b, m, 0, used, pick, 0, &best, bestPick);
+
+  for (int i = 0; i < n; i++) {
+    uint8_t from = fromExtra ? a[i] : b[bestPick[i]];
+    uint8_t to = fromExtra ? b[bestPick[i]] : a[i];
+    cc_square_name(from, plan->moves[plan->count]);
+    cc_square_name(to, plan->moves[plan->count] + 2);
+    plan->count++;
+    plan->extra &= ~(1ULL << from);
+    plan->missing &= ~(1ULL << to);
+  }
+  return true;
+}
+
+// "a1 c3 h8" for the squares set in squares, truncated to fit out
+void squareListName(uint64_t squares, char* out, size_t outSize) {
+  size_t n = 0;
+  out[0] = '\0';
+  for (uint8_t sq = 0; sq < 64; sq++) {
+    if (!((squares >> sq) & 1) || n + 4 > outSize) continue;
+    if (n) out[n++] = ' ';
+    cc_square_name(sq, out + n);
+    n += 2;
+  }
+}
@@ -0,0 +1,118 @@
+#ifndef BRIDGE_CORE_H
+#define BRIDGE_CORE_H
+
+/*
+  Bridge logic with no Arduino / network dependencies: board tracking, NDJSON stream
+  handling, ATmega payload building and move normalisation. Builds with the sketch and
+  natively on Linux (host/ benchmark); only ArduinoJson (6.x) and src/chess_core (the
+  position model shared with the ATmega firmware) are needed.
+
+  The embedding program provides the hooks declared at the bottom.
+*/
+
+#include <stdint.h>
+#include <stddef.h>
+#include "src/chess_core/chess_core.h"
+
+// Longest payload to the ATmega is a castle: 8 chars
+const size_t PAYLOAD_MAX = 9;
+
+enum PlayerColor { COLOR_NONE, COLOR_WHITE, COLOR_BLACK };
+
+// ownership tracking
+extern PlayerColor myColor;
+extern char myLichessId[32];        // lowercased
+extern char lastProcessedMove[6];   // last UCI move handled (4 chars, 5 with promotion)
+
+// incremental move-list tracking: only the tail past movesOffset is parsed per gameState
+extern int plyCount;                // plies applied to position_
+extern size_t movesOffset;          // byte offset just past lastProcessedMove in the stream's "moves" string
+
+// Track last move that came FROM the ATmega/Serial (payload format that would be sent to ATmega)
+extern char lastMoveFromAtmega[PAYLOAD_MAX];
+
+// game position, for capture / castling classification of streamed moves
+extern cc_position_t position_;
+
+// id of the game the stream is following, from its gameFull
+extern char streamGameId[16];
+
+// Everything needed to continue a game without replaying its move list. Handed to
+// bridgeSaveCheckpoint() whenever moves are applied; the sketch keeps it in NVS and offers
+// it back with setResumeCheckpoint() after a reboot.
+const uint32_t CHECKPOINT_MAGIC = 0xB1C40001;  // bump the low half when the layout changes
+struct BridgeCheckpoint {
+  uint32_t magic;
+  char gameId[16];
+  cc_position_t position;
+  int32_t plyCount;
+  uint32_t movesOffset;
+  char lastProcessedMove[6];
+};
+
+// Latency / memory figures, printed with the "stats" Serial Monitor command
+struct StreamStats {
+  uint32_t lines = 0;
+  uint32_t moves = 0;
+  uint32_t parseErrors = 0;
+  uint32_t lastUs = 0;       // last handleStreamLine() duration
+  uint32_t maxUs = 0;
+  uint64_t totalUs = 0;
+};
+extern StreamStats streamStats;
+
+// A move applied from the game stream
+struct BridgeMove {
+  const char* uci;
+  const char* captureSq;     // "" if no capture
+  const char* payload;       // what the ATmega gets
+  int ply;                   // 1-based
+  bool isMyMove;
+  bool emit;                 // new move: report it / send it to the ATmega
+  bool suppressed;           // echo of lastMoveFromAtmega, don't send
+  bool lastInList;           // final move of this event's list
+};
+
+// ---------- Board ----------
+void resetMoveTracking();
+bool applyUciMoveToBoard(const char* uci, cc_move_t* mv);
+void fillCheckpoint(BridgeCheckpoint* cp);
+void setResumeCheckpoint(const BridgeCheckpoint* cp);
+
+// ---------- Payloads ----------
+void buildPayloadForUciSimple(const char* uci, char out[PAYLOAD_MAX]);
+void buildPayloadForStreamMove(const cc_move_t* mv, char out[PAYLOAD_MAX]);
+bool normalizeATmegaMove(const char* in, char out[6]);
+uint16_t splitMoveSeq(char* line);
+
+// ---------- Streams ----------
+void setMyLichessId(const char* id);
+void buildStreamFilter();
+const char* colorName(PlayerColor c);
+void applyMovesTail(const char* moves, size_t len, bool emit);
+bool movesPrefixMatches(const char* moves, size_t len);
+void handleStreamLine(char* line, size_t len);
+bool parseEventLine(char* line, size_t len, const char** type, const char** gameId);
+bool parsePlayingForGameId(const char* json, char* out, size_t outSize);
+
+// ---------- Resync ----------
+// The ATmega answers "occ <ply>" with "oc:<ply> <16 hex: one byte per file, bit = rank>
+// <detector state>"; planResync() compares that with cc_occupancy(&position_).
+const int RESYNC_MAX_MOVES = 4;     // more differences than this: the board needs a hand
+struct ResyncPlan {
+  int count;                        // gantry moves in moves[]
+  char moves[RESYNC_MAX_MOVES][5];  // "<from><to>", sent to the ATmega as "fix <from><to>"
+  uint64_t extra;                   // occupied but should be empty, not covered by a move
+  uint64_t missing;                 // empty but should be occupied, not covered by a move
+};
+bool parseOccupancyReply(const char* line, int* ply, uint64_t* occ, int* state);
+bool planResync(uint64_t expected, uint64_t actual, ResyncPlan* plan);
+void squareListName(uint64_t squares, char* out, size_t outSize);
+
+// ---------- Hooks (provided by the sketch / host program) ----------
+void bridgeLog(const char* fmt, ...);
+void bridgeOnStreamMove(const BridgeMove& mv);
+uint32_t bridgeMicros();
+void bridgeSaveCheckpoint(const BridgeCheckpoint& cp);
+
+#endif
@@ -0,0 +1,153 @@
+/*
+  Native replay benchmark for bridge_core.
+
+  Feeds each game of a move file through handleStreamLine() the way the Lichess board
+  stream delivers it (gameFull, then one gameState per ply with the growing move list),
+  once as white and once as black, and reports per-move processing time and memory.
+
+  Build (ArduinoJson 6 is header-only):
+    gcc -O2 -c ../src/chess_core/chess_core.c -o chess_core.o
+    g++ -O2 -std=c++17 -I.. -I<ArduinoJson>/src bridge_bench.cpp ../bridge_core.cpp chess_core.o -o bridge_bench
+  Run:
+    ./bridge_bench [games.txt] [repeat]
+*/
+
+#include "bridge_core.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <malloc.h>
+#include <sys/resource.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+static bool verbose = false;
+static uint32_t movesReported = 0;
+static uint32_t capturesReported = 0;
+
+// ---------- bridge_core hooks ----------
+void bridgeLog(const char* fmt, ...) {
+  if (!verbose) return;
+  va_list ap;
+  va_start(ap, fmt);
+  vprintf(fmt, ap);
+  va_end(ap);
+}
+
+uint32_t bridgeMicros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000000ull + ts.tv_nsec / 1000);
+}
+
+void bridgeOnStreamMove(const BridgeMove& mv) {
+  if (!mv.emit) return;
+  movesReported++;
+  if (mv.captureSq[0]) capturesReported++;
+  if (verbose) printf("ply %d %s -> %s\n", mv.ply, mv.uci, mv.payload);
+}
+
+// the sketch writes this to NVS; keeping a copy costs about the same as its memcpy
+static BridgeCheckpoint lastCheckpoint;
+void bridgeSaveCheckpoint(const BridgeCheckpoint& cp) {
+  lastCheckpoint = cp;
+}
+
+static uint64_t nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+static std::vector<std::string> loadGames(const char* path) {
+  std::vector<std::string> games;
+  FILE* f = fopen(path, "r");
+  if (!f) {
+    perror(path);
+    exit(1);
+  }
+  char line[4096];
+  while (fgets(line, sizeof(line), f)) {
+    line[strcspn(line, "\r\n")] = '\0';
+    if (line[0] == '\0' || line[0] == '#') continue;
+    games.push_back(line);
+  }
+  fclose(f);
+  return games;
+}
+
+// Replay one game; handleStreamLine() edits the line in place so every call gets a fresh copy
+static void replayGame(const std::string& moves, bool asWhite, std::vector<uint32_t>& moveNs) {
+  char line[4608];
+  snprintf(line, sizeof(line),
+           "{\"type\":\"gameFull\",\"id\":\"bench\",\"white\":{\"id\":\"%s\"},\"black\":{\"id\":\"%s\"},"
+           "\"state\":{\"type\":\"gameState\",\"moves\":\"\",\"status\":\"started\"}}",
+           asWhite ? "me" : "them", asWhite ? "them" : "me");
+  handleStreamLine(line, strlen(line));
+
+  size_t pos = 0;
+  while (pos < moves.size()) {
+    size_t end = moves.find(' ', pos);
+    if (end == std::string::npos) end = moves.size();
+    int n = snprintf(line, sizeof(line), "{\"type\":\"gameState\",\"moves\":\"%.*s\",\"wtime\":60000,\"btime\":60000,\"status\":\"started\"}",
+                     (int)end, moves.c_str());
+    uint64_t t0 = nowNs();
+    handleStreamLine(line, n);
+    moveNs.push_back((uint32_t)(nowNs() - t0));
+    pos = end + 1;
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* path = "games.txt";
+  int repeat = 200;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-v") == 0) verbose = true;
+    else if (argv[i][0] >= '0' && argv[i][0] <= '9') repeat = atoi(argv[i]);
+    else path = argv[i];
+  }
+  if (verbose) repeat = 1;
+
+  std::vector<std::string> games = loadGames(path);
+  setMyLichessId("me");
+  buildStreamFilter();
+
+  std::vector<uint32_t> moveNs;
+  moveNs.reserve(games.size() * 256 * 2 * repeat);
+  struct mallinfo2 before = mallinfo2();
+
+  for (int r = 0; r < repeat; r++) {
+    for (const std::string& g : games) {
+      replayGame(g, true, moveNs);
+      replayGame(g, false, moveNs);
+    }
+  }
+  struct mallinfo2 after = mallinfo2();
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+
+  if (moveNs.empty()) {
+    printf("no moves in %s\n", path);
+    return 1;
+  }
+  std::sort(moveNs.begin(), moveNs.end());
+  uint64_t total = 0;
+  for (uint32_t ns : moveNs) total += ns;
+  size_t n = moveNs.size();
+
+  printf("games %zu x %d x 2 colours, gameState lines %zu, moves reported %u (captures %u)\n",
+         games.size(), repeat, n, (unsigned)movesReported, (unsigned)capturesReported);
+  printf("per move ns: min %u  p50 %u  p99 %u  max %u  avg %llu\n",
+         moveNs[0], moveNs[n / 2], moveNs[n * 99 / 100], moveNs[n - 1], (unsigned long long)(total / n));
+  printf("stream stats: lines %u  parse errors %u  max %u us\n",
+         (unsigned)streamStats.lines, (unsigned)streamStats.parseErrors, (unsigned)streamStats.maxUs);
+  printf("heap in use: before %zu  after %zu bytes; max RSS %ld KiB\n",
+         before.uordblks, after.uordblks, ru.ru_maxrss);
+  printf("bridge_core static state: position %zu, lichess id %zu, stream stats %zu bytes\n",
+         sizeof(position_), sizeof(myLichessId), sizeof(streamStats));
+  return streamStats.parseErrors ? 1 : 0;
+}
@@ -0,0 +1,115 @@
+/*
+  Host tests for the bridge_core helpers that parse and build ATmega link lines: move
+  normalisation, "#n" sequence suffixes, the "oc:" occupancy reply (including truncated
+  lines) and the resync plan.
+
+  Build (ArduinoJson 6 is header-only):
+    gcc -O2 -c ../src/chess_core/chess_core.c -o chess_core.o
+    g++ -O2 -std=c++17 -I.. -I<ArduinoJson>/src bridge_core_test.cpp ../bridge_core.cpp chess_core.o -o bridge_core_test
+  Run:
+    ./bridge_core_test
+  Prints each failed check and exits 1 if there was any. Add -fsanitize=address to both
+  compiles to have the truncated "oc:" lines fail on any read past their end.
+*/
+
+#include "bridge_core.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static unsigned checks, failures;
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+static void check(bool ok, const char* what, int line) {
+  checks++;
+  if (ok) return;
+  failures++;
+  printf("line %d: failed: %s\n", line, what);
+}
+
+// ---------- bridge_core hooks ----------
+void bridgeLog(const char*, ...) {}
+void bridgeOnStreamMove(const BridgeMove&) {}
+uint32_t bridgeMicros() { return 0; }
+void bridgeSaveCheckpoint(const BridgeCheckpoint&) {}
+
+// Parse line from a heap block of exactly its size, so a read past the terminator is
+// out of bounds (and caught under -fsanitize=address)
+static bool parseExact(const char* line, int* ply, uint64_t* occ, int* state) {
+  size_t n = strlen(line) + 1;
+  char* copy = (char*)malloc(n);
+  memcpy(copy, line, n);
+  bool ok = parseOccupancyReply(copy, ply, occ, state);
+  free(copy);
+  return ok;
+}
+
+static void testNormalize() {
+  char out[6];
+  CHECK(normalizeATmegaMove("e2e4", out) && strcmp(out, "e2e4") == 0);
+  CHECK(normalizeATmegaMove("E2 - E4", out) && strcmp(out, "e2e4") == 0);
+  CHECK(normalizeATmegaMove("a7a8q", out) && strcmp(out, "a7a8q") == 0);
+  CHECK(!normalizeATmegaMove("e5d6d5", out) && out[0] == '\0');
+  CHECK(!normalizeATmegaMove("e2", out));
+}
+
+static void testSeq() {
+  char line[16];
+  strcpy(line, "e2e4#17");
+  CHECK(splitMoveSeq(line) == 17 && strcmp(line, "e2e4") == 0);
+  strcpy(line, "e1g1h1f1");
+  CHECK(splitMoveSeq(line) == 0 && strcmp(line, "e1g1h1f1") == 0);
+}
+
+static void testOccupancy() {
+  int ply = -1, state = -1;
+  uint64_t occ = 0;
+  CHECK(parseExact("oc:12 c3c3c3c3c3c3c3c3 0", &ply, &occ, &state));
+  CHECK(ply == 12 && occ == 0xC3C3C3C3C3C3C3C3ULL && state == 0);
+  CHECK(parseExact("oc:0 0100000000000080 3", &ply, &occ, &state));
+  CHECK(occ == 0x8000000000000001ULL && state == 3);
+
+  // truncated anywhere in the hex, or before the state
+  const char* full = "oc:7 c3c3c3c3c3c3c3c3 0";
+  char line[32];
+  for (size_t n = 5; n < strlen(full) - 1; n++) {
+    snprintf(line, sizeof(line), "%.*s", (int)n, full);
+    checks++;
+    if (parseExact(line, &ply, &occ, &state)) {
+      failures++;
+      printf("accepted truncated line \"%s\"\n", line);
+    }
+  }
+  CHECK(!parseExact("oc:", &ply, &occ, &state));
+  CHECK(!parseExact("oc:7", &ply, &occ, &state));
+  CHECK(!parseExact("oc:7 c3c3c3c3c3c3c3cg 0", &ply, &occ, &state));
+  CHECK(!parseExact("oc:x c3c3c3c3c3c3c3c3 0", &ply, &occ, &state));
+  CHECK(!parseExact("rp:7 c3c3c3c3c3c3c3c3 0", &ply, &occ, &state));
+}
+
+static void testResync() {
+  ResyncPlan plan;
+  uint64_t start = 0xC3C3C3C3C3C3C3C3ULL;
+  CHECK(!planResync(start, start, &plan));
+  // the e2 pawn stands on e4 instead
+  uint64_t e2 = 1ULL << (4 * 8 + 1), e4 = 1ULL << (4 * 8 + 3);
+  CHECK(planResync(start, (start & ~e2) | e4, &plan));
+  CHECK(plan.count == 1 && strcmp(plan.moves[0], "e4e2") == 0 && !plan.extra && !plan.missing);
+  // a piece gone: nothing to move, one square for a hand
+  CHECK(planResync(start, start & ~e2, &plan));
+  CHECK(plan.count == 0 && plan.missing == e2 && !plan.extra);
+  char names[16];
+  squareListName(e2 | e4, names, sizeof(names));
+  CHECK(strcmp(names, "e2 e4") == 0);
+}
+
+int main() {
+  testNormalize();
+  testSeq();
+  testOccupancy();
+  testResync();
+  printf("%u checks, %u failed\n", checks, failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+Local stand-in for the parts of the Lichess board API the bridge uses:
+
+  GET  /api/account/playing                 current game
+  GET  /api/stream/event                    NDJSON: gameStart for the current game
+  GET  /api/board/game/stream/<id>          NDJSON: gameFull, then a gameState per move
+  POST /api/board/game/<id>/move/<uci>      our move
+
+The opponent's moves are taken from a game in games.txt and played --delay seconds after
+each of ours. The bridge always uses TLS, so pass a certificate, e.g.
+
+  openssl req -x509 -newkey rsa:2048 -nodes -days 365 -subj /CN=mock \\
+      -keyout key.pem -out cert.pem
+  ./mock_lichess.py --cert cert.pem --key key.pem --game 1 --colour white
+
+and build the sketch with LICHESS_HOST / LICHESS_PORT pointing at this machine. Streams are
+sent without chunked encoding and closed when the game ends, like the bridge expects.
+Timing of each POST -> gameState round trip is printed so it can be read against the
+bridge's own "stats" output.
+"""
+
+import argparse
+import json
+import ssl
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+GAME_ID = "mockgame"
+
+
+class Game:
+    def __init__(self, moves, colour, user, delay):
+        self.script = moves
+        self.colour = colour
+        self.user = user
+        self.delay = delay
+        self.moves = []
+        self.status = "started"
+        self.cond = threading.Condition()
+
+    def my_turn(self):
+        return (len(self.moves) % 2 == 0) == (self.colour == "white")
+
+    def play(self, uci):
+        with self.cond:
+            self.moves.append(uci)
+            if len(self.moves) >= len(self.script):
+                self.status = "mate"
+            self.cond.notify_all()
+
+    def opponent(self):
+        # plays the scripted reply whenever it is the opponent's turn
+        while True:
+            with self.cond:
+                while self.status == "started" and self.my_turn():
+                    self.cond.wait()
+                if self.status != "started":
+                    return
+                ply = len(self.moves)
+            time.sleep(self.delay)
+            print(f"opponent: {self.script[ply]}")
+            self.play(self.script[ply])
+
+    def full(self):
+        me = {"id": self.user.lower(), "name": self.user}
+        them = {"id": "mockopponent", "name": "MockOpponent"}
+        white, black = (me, them) if self.colour == "white" else (them, me)
+        return {"type": "gameFull", "id": GAME_ID, "white": white, "black": black,
+                "state": self.state()}
+
+    def state(self):
+        return {"type": "gameState", "moves": " ".join(self.moves),
+                "wtime": 600000, "btime": 600000, "winc": 0, "binc": 0, "status": self.status}
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+    game = None
+
+    def log_message(self, fmt, *args):
+        pass
+
+    def send_json(self, code, obj):
+        body = json.dumps(obj).encode()
+        self.send_response(code)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def start_ndjson(self):
+        self.send_response(200)
+        self.send_header("Content-Type", "application/x-ndjson")
+        self.send_header("Connection", "close")
+        self.end_headers()
+        self.close_connection = True
+
+    def write_line(self, obj):
+        self.wfile.write((json.dumps(obj) + "\n").encode() if obj is not None else b"\n")
+        self.wfile.flush()
+
+    def do_GET(self):
+        g = self.game
+        try:
+            if self.path == "/api/account/playing":
+                playing = [] if g.status != "started" else [
+                    {"gameId": GAME_ID, "fullId": GAME_ID + "0000", "color": g.colour, "isMyTurn": g.my_turn()}]
+                self.send_json(200, {"nowPlaying": playing})
+            elif self.path == "/api/stream/event":
+                self.start_ndjson()
+                self.write_line({"type": "gameStart", "game": {"gameId": GAME_ID, "id": GAME_ID}})
+                while g.status == "started":
+                    time.sleep(6)
+                    self.write_line(None)  # keep-alive, as Lichess sends
+                self.write_line({"type": "gameFinish", "game": {"gameId": GAME_ID, "id": GAME_ID}})
+            elif self.path == "/api/board/game/stream/" + GAME_ID:
+                self.start_ndjson()
+                with g.cond:
+                    sent = len(g.moves)
+                    self.write_line(g.full())
+                while True:
+                    with g.cond:
+                        if len(g.moves) == sent and g.status == "started":
+                            g.cond.wait(6)
+                        if len(g.moves) == sent and g.status == "started":
+                            line = None
+                        else:
+                            sent = len(g.moves)
+                            line = g.state()
+                    self.write_line(line)
+                    if line is not None and line["status"] != "started":
+                        return
+            else:
+                self.send_json(404, {"error": "Not found"})
+        except (BrokenPipeError, ConnectionResetError):
+            pass
+
+    def do_POST(self):
+        g = self.game
+        prefix = "/api/board/game/" + GAME_ID + "/move/"
+        if not self.path.startswith(prefix):
+            self.send_json(404, {"error": "Not found"})
+            return
+        uci = self.path[len(prefix):]
+        if g.status != "started" or not g.my_turn():
+            self.send_json(400, {"error": "Not your turn, or game already over"})
+            return
+        expected = g.script[len(g.moves)]
+        if uci != expected:
+            print(f"note: {uci} differs from the script ({expected}); opponent replies may be illegal")
+        t0 = time.monotonic()
+        g.play(uci)
+        self.send_json(200, {"ok": True})
+        print(f"move {uci} accepted in {(time.monotonic() - t0) * 1000:.1f} ms")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--games", default="games.txt")
+    ap.add_argument("--game", type=int, default=0, help="index into the games file")
+    ap.add_argument("--colour", choices=("white", "black"), default="white", help="the bridge's side")
+    ap.add_argument("--user", default="bridgeuser", help="must match LICHESS_USER in the sketch")
+    ap.add_argument("--delay", type=float, default=1.0, help="seconds before each opponent reply")
+    ap.add_argument("--port", type=int, default=8443)
+    ap.add_argument("--cert")
+    ap.add_argument("--key")
+    args = ap.parse_args()
+
+    with open(args.games) as f:
+        games = [l.split() for l in f if l.strip() and not l.startswith("#")]
+    Handler.game = Game(games[args.game], args.colour, args.user, args.delay)
+    threading.Thread(target=Handler.game.opponent, daemon=True).start()
+
+    server = ThreadingHTTPServer(("", args.port), Handler)
+    if args.cert:
+        ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        ctx.load_cert_chain(args.cert, args.key)
+        server.socket = ctx.wrap_socket(server.socket, server_side=True)
+    print(f"mock lichess on port {args.port} ({'https' if args.cert else 'http'}), "
+          f"game {args.game}, bridge plays {args.colour}")
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+Build a per-move latency timeline from a bridge Serial Monitor log (MOVE_TRACE builds).
+
+  ESP points:    tr:<seq>:<point>:<esp us>
+  ATmega points: tr:<seq>:<point>:<atmega us>:<esp us when received>
+
+The ATmega clock is mapped onto the ESP clock with the smallest (received - sent)
+difference seen in the log, so ATmega times are late by at most one trace line's transfer
+time (~25 ms at 9600 baud) minus the fastest one. Local moves have odd ids:
+a.scan -> a.tx -> e.rx -> e.post -> e.resp -> e.ack. Streamed moves have even ids:
+e.stream -> e.tx -> a.rx -> a.start -> a.end.
+
+  ./trace_timeline.py bridge.log                  text report
+  ./trace_timeline.py bridge.log --chrome t.json  also write a Chrome trace (chrome://tracing, ui.perfetto.dev)
+"""
+
+import argparse
+import json
+import re
+import sys
+from collections import defaultdict
+
+TRACE_RE = re.compile(r"tr:(\d+):([\w.]+):(\d+)(?::(\d+))?\s*$")
+ORDER = ["a.scan", "a.tx", "e.rx", "e.post", "e.resp", "e.ack",
+         "e.stream", "e.tx", "a.rx", "a.start", "a.end"]
+
+
+def parse(lines):
+    esp, atmega = [], []
+    for line in lines:
+        m = TRACE_RE.search(line)
+        if not m:
+            continue
+        seq, point, t = int(m.group(1)), m.group(2), int(m.group(3))
+        if m.group(4) is not None:
+            atmega.append((seq, point, t, int(m.group(4))))
+        else:
+            esp.append((seq, point, t))
+    return esp, atmega
+
+
+def build(esp, atmega):
+    offset = min((rx - t for _, _, t, rx in atmega), default=0)
+    moves = defaultdict(dict)
+    for seq, point, t in esp:
+        moves[seq][point] = t
+    for seq, point, t, _ in atmega:
+        moves[seq][point] = t + offset
+    return moves
+
+
+def report(moves, out):
+    stage_stats = defaultdict(list)
+    for seq in sorted(moves):
+        pts = sorted(moves[seq].items(), key=lambda kv: (kv[1], ORDER.index(kv[0]) if kv[0] in ORDER else 99))
+        kind = "local" if seq % 2 else "stream"
+        t0 = pts[0][1]
+        out.write(f"#{seq} ({kind})\n")
+        prev = None
+        for point, t in pts:
+            step = "" if prev is None else f"  +{(t - prev[1]) / 1000:9.1f} ms"
+            out.write(f"  {point:8} {(t - t0) / 1000:9.1f} ms{step}\n")
+            if prev is not None:
+                stage_stats[f"{prev[0]} -> {point}"].append(t - prev[1])
+            prev = (point, t)
+        out.write(f"  total    {(pts[-1][1] - t0) / 1000:9.1f} ms\n")
+
+    if stage_stats:
+        out.write("\nstage                     n    mean ms     max ms\n")
+        for stage, v in sorted(stage_stats.items(), key=lambda kv: -sum(kv[1]) / len(kv[1])):
+            out.write(f"{stage:22} {len(v):4} {sum(v) / len(v) / 1000:10.1f} {max(v) / 1000:10.1f}\n")
+
+
+def chrome_trace(moves):
+    events = []
+    for seq, pts in moves.items():
+        ordered = sorted(pts.items(), key=lambda kv: kv[1])
+        tid = 1 if seq % 2 else 2
+        for (p0, t0), (p1, t1) in zip(ordered, ordered[1:]):
+            events.append({"name": f"#{seq} {p0} -> {p1}", "ph": "X", "ts": t0, "dur": max(t1 - t0, 1),
+                           "pid": 1, "tid": tid, "args": {"seq": seq}})
+    events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": 1, "args": {"name": "local moves"}})
+    events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": 2, "args": {"name": "streamed moves"}})
+    return {"traceEvents": events, "displayTimeUnit": "ms"}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("log", nargs="?", help="Serial Monitor log, stdin if omitted")
+    ap.add_argument("--chrome", help="write a Chrome trace-event JSON file")
+    args = ap.parse_args()
+
+    src = open(args.log, errors="replace") if args.log else sys.stdin
+    esp, atmega = parse(src)
+    moves = build(esp, atmega)
+    if not moves:
+        sys.exit("no tr: lines found (is the bridge built with MOVE_TRACE?)")
+    report(moves, sys.stdout)
+    if args.chrome:
+        with open(args.chrome, "w") as f:
+            json.dump(chrome_trace(moves), f)
+
+
+if __name__ == "__main__":
+    main()
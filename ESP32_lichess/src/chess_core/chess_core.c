@@ -0,0 +1,621 @@
+#include "chess_core.h"
+#include <string.h>
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#define CC_FLASH PROGMEM
+#define cc_read_u8(p) pgm_read_byte(p)
+static uint64_t cc_read_bb(const uint64_t* p) {
+    uint64_t v;
+    memcpy_P(&v, p, sizeof(v));
+    return v;
+}
+#define cc_read_position(dst, src) memcpy_P((dst), (src), sizeof(cc_position_t))
+#else
+#define CC_FLASH
+#define cc_read_u8(p) (*(p))
+#define cc_read_bb(p) (*(p))
+#define cc_read_position(dst, src) memcpy((dst), (src), sizeof(cc_position_t))
+#endif
+
+// ---------- Compile-time tables ----------
+#define CC_ON(f, r) ((f) >= 0 && (f) < 8 && (r) >= 0 && (r) < 8)
+#define CC_BIT(f, r) (CC_ON(f, r) ? ((uint64_t)1 << ((CC_ON(f, r) ? (f) : 0) * 8 + (CC_ON(f, r) ? (r) : 0))) : 0)
+#define CC_F(sq) ((sq) / 8)
+#define CC_R(sq) ((sq) % 8)
+
+#define CC_KNIGHT_BB(sq) \
+    (CC_BIT(CC_F(sq) + 1, CC_R(sq) + 2) | CC_BIT(CC_F(sq) + 2, CC_R(sq) + 1) | \
+     CC_BIT(CC_F(sq) + 2, CC_R(sq) - 1) | CC_BIT(CC_F(sq) + 1, CC_R(sq) - 2) | \
+     CC_BIT(CC_F(sq) - 1, CC_R(sq) - 2) | CC_BIT(CC_F(sq) - 2, CC_R(sq) - 1) | \
+     CC_BIT(CC_F(sq) - 2, CC_R(sq) + 1) | CC_BIT(CC_F(sq) - 1, CC_R(sq) + 2))
+
+#define CC_KING_BB(sq) \
+    (CC_BIT(CC_F(sq) - 1, CC_R(sq) - 1) | CC_BIT(CC_F(sq), CC_R(sq) - 1) | CC_BIT(CC_F(sq) + 1, CC_R(sq) - 1) | \
+     CC_BIT(CC_F(sq) - 1, CC_R(sq))     |                                 CC_BIT(CC_F(sq) + 1, CC_R(sq))     | \
+     CC_BIT(CC_F(sq) - 1, CC_R(sq) + 1) | CC_BIT(CC_F(sq), CC_R(sq) + 1) | CC_BIT(CC_F(sq) + 1, CC_R(sq) + 1))
+
+// Castling rights that survive a move touching sq (as from or to square)
+#define CC_CASTLE_KEEP(sq) ((uint8_t)(0x0F & ~( \
+    ((sq) == 0  ? CC_CASTLE_WQ : 0) | ((sq) == 32 ? CC_CASTLE_WK | CC_CASTLE_WQ : 0) | \
+    ((sq) == 56 ? CC_CASTLE_WK : 0) | ((sq) == 7  ? CC_CASTLE_BQ : 0) | \
+    ((sq) == 39 ? CC_CASTLE_BK | CC_CASTLE_BQ : 0) | ((sq) == 63 ? CC_CASTLE_BK : 0))))
+
+#define CC_FILE8(M, f) M((f) * 8 + 0), M((f) * 8 + 1), M((f) * 8 + 2), M((f) * 8 + 3), \
+                       M((f) * 8 + 4), M((f) * 8 + 5), M((f) * 8 + 6), M((f) * 8 + 7)
+#define CC_TABLE64(M) CC_FILE8(M, 0), CC_FILE8(M, 1), CC_FILE8(M, 2), CC_FILE8(M, 3), \
+                      CC_FILE8(M, 4), CC_FILE8(M, 5), CC_FILE8(M, 6), CC_FILE8(M, 7)
+
+static const uint64_t knight_attacks[64] CC_FLASH = { CC_TABLE64(CC_KNIGHT_BB) };
+static const uint64_t king_attacks[64] CC_FLASH = { CC_TABLE64(CC_KING_BB) };
+static const uint8_t castle_keep[64] CC_FLASH = { CC_TABLE64(CC_CASTLE_KEEP) };
+
+static const cc_position_t start_position CC_FLASH = {
+    { 0x0303030303030303ULL, 0xC0C0C0C0C0C0C0C0ULL },
+    {
+        0x4242424242424242ULL,  // pawns
+        0x0081000000008100ULL,  // knights
+        0x0000810000810000ULL,  // bishops
+        0x8100000000000081ULL,  // rooks
+        0x0000000081000000ULL,  // queens
+        0x0000008100000000ULL,  // kings
+    },
+    CC_WHITE,
+    CC_CASTLE_WK | CC_CASTLE_WQ | CC_CASTLE_BK | CC_CASTLE_BQ,
+    CC_NO_SQUARE,
+    0,
+    1,
+};
+
+static const char piece_chars[] = " pnbrqk";
+
+// ---------- Position ----------
+static void put_piece(cc_position_t* pos, uint8_t sq, uint8_t piece) {
+    uint64_t b = CC_BB(sq);
+    pos->color[CC_COLOR(piece)] |= b;
+    pos->type[CC_TYPE(piece) - 1] |= b;
+}
+
+static void remove_piece(cc_position_t* pos, uint8_t sq, uint8_t piece) {
+    uint64_t b = ~CC_BB(sq);
+    pos->color[CC_COLOR(piece)] &= b;
+    pos->type[CC_TYPE(piece) - 1] &= b;
+}
+
+void cc_position_start(cc_position_t* pos) {
+    cc_read_position(pos, &start_position);
+}
+
+uint64_t cc_occupancy(const cc_position_t* pos) {
+    return pos->color[CC_WHITE] | pos->color[CC_BLACK];
+}
+
+uint8_t cc_piece_at(const cc_position_t* pos, uint8_t sq) {
+    uint64_t b = CC_BB(sq);
+    uint8_t color;
+    if (pos->color[CC_WHITE] & b) color = CC_WHITE;
+    else if (pos->color[CC_BLACK] & b) color = CC_BLACK;
+    else return 0;
+    for (uint8_t t = 0; t < 6; t++) {
+        if (pos->type[t] & b) return CC_PIECE(color, t + 1);
+    }
+    return 0;
+}
+
+uint8_t cc_parse_square(const char* s) {
+    if (s[0] < 'a' || s[0] > 'h' || s[1] < '1' || s[1] > '8') return CC_NO_SQUARE;
+    return CC_SQUARE(s[0] - 'a', s[1] - '1');
+}
+
+void cc_square_name(uint8_t sq, char out[3]) {
+    if (sq >= CC_NO_SQUARE) {
+        out[0] = out[1] = '-';
+    } else {
+        out[0] = (char)('a' + CC_FILE(sq));
+        out[1] = (char)('1' + CC_RANK(sq));
+    }
+    out[2] = '\0';
+}
+
+static uint8_t piece_from_char(char c) {
+    uint8_t color = CC_BLACK;
+    if (c >= 'A' && c <= 'Z') {
+        color = CC_WHITE;
+        c = (char)(c - 'A' + 'a');
+    } else if (c < 'a' || c > 'z') {
+        return 0;
+    }
+    const char* p = strchr(piece_chars + 1, c);
+    if (p == NULL) return 0;
+    return CC_PIECE(color, p - piece_chars);
+}
+
+// Only the placement field is required; missing fields take start-position defaults
+bool cc_from_fen(cc_position_t* pos, const char* fen) {
+    cc_position_t p;
+    memset(&p, 0, sizeof(p));
+    p.ep = CC_NO_SQUARE;
+    p.fullmove = 1;
+
+    int8_t file = 0, rank = 7;
+    for (; *fen && *fen != ' '; fen++) {
+        char c = *fen;
+        if (c == '/') {
+            if (file != 8 || rank == 0) return false;
+            rank--;
+            file = 0;
+        } else if (c >= '1' && c <= '8') {
+            file += c - '0';
+            if (file > 8) return false;
+        } else {
+            uint8_t piece = piece_from_char(c);
+            if (!piece || file > 7) return false;
+            put_piece(&p, CC_SQUARE(file, rank), piece);
+            file++;
+        }
+    }
+    if (rank != 0 || file != 8) return false;
+
+    while (*fen == ' ') fen++;
+    if (*fen == 'b') p.side = CC_BLACK;
+    if (*fen) fen++;
+
+    while (*fen == ' ') fen++;
+    for (; *fen && *fen != ' '; fen++) {
+        if (*fen == 'K') p.castling |= CC_CASTLE_WK;
+        else if (*fen == 'Q') p.castling |= CC_CASTLE_WQ;
+        else if (*fen == 'k') p.castling |= CC_CASTLE_BK;
+        else if (*fen == 'q') p.castling |= CC_CASTLE_BQ;
+    }
+
+    while (*fen == ' ') fen++;
+    if (*fen && *fen != '-') p.ep = cc_parse_square(fen);
+    while (*fen && *fen != ' ') fen++;
+
+    while (*fen == ' ') fen++;
+    if (*fen) {
+        unsigned n = 0;
+        for (; *fen >= '0' && *fen <= '9'; fen++) n = n * 10 + (unsigned)(*fen - '0');
+        p.halfmove = n > 255 ? 255 : (uint8_t)n;
+        while (*fen == ' ') fen++;
+        if (*fen >= '1' && *fen <= '9') {
+            for (n = 0; *fen >= '0' && *fen <= '9'; fen++) n = n * 10 + (unsigned)(*fen - '0');
+            p.fullmove = (uint16_t)n;
+        }
+    }
+
+    *pos = p;
+    return true;
+}
+
+static size_t append_uint(char* out, size_t i, size_t size, unsigned n) {
+    char digits[5];
+    uint8_t d = 0;
+    do {
+        digits[d++] = (char)('0' + n % 10);
+        n /= 10;
+    } while (n && d < sizeof(digits));
+    while (d && i + 1 < size) out[i++] = digits[--d];
+    return i;
+}
+
+void cc_to_fen(const cc_position_t* pos, char* out, size_t size) {
+    size_t i = 0;
+    if (size == 0) return;
+#define CC_PUT(ch) do { if (i + 1 < size) out[i++] = (ch); } while (0)
+    for (int8_t rank = 7; rank >= 0; rank--) {
+        uint8_t empty = 0;
+        for (uint8_t file = 0; file < 8; file++) {
+            uint8_t piece = cc_piece_at(pos, CC_SQUARE(file, rank));
+            if (!piece) {
+                empty++;
+                continue;
+            }
+            if (empty) CC_PUT((char)('0' + empty));
+            empty = 0;
+            char c = piece_chars[CC_TYPE(piece)];
+            CC_PUT(CC_COLOR(piece) == CC_WHITE ? (char)(c - 'a' + 'A') : c);
+        }
+        if (empty) CC_PUT((char)('0' + empty));
+        if (rank) CC_PUT('/');
+    }
+    CC_PUT(' ');
+    CC_PUT(pos->side == CC_WHITE ? 'w' : 'b');
+    CC_PUT(' ');
+    if (!pos->castling) CC_PUT('-');
+    if (pos->castling & CC_CASTLE_WK) CC_PUT('K');
+    if (pos->castling & CC_CASTLE_WQ) CC_PUT('Q');
+    if (pos->castling & CC_CASTLE_BK) CC_PUT('k');
+    if (pos->castling & CC_CASTLE_BQ) CC_PUT('q');
+    CC_PUT(' ');
+    if (pos->ep == CC_NO_SQUARE) {
+        CC_PUT('-');
+    } else {
+        CC_PUT((char)('a' + CC_FILE(pos->ep)));
+        CC_PUT((char)('1' + CC_RANK(pos->ep)));
+    }
+    CC_PUT(' ');
+    i = append_uint(out, i, size, pos->halfmove);
+    CC_PUT(' ');
+    i = append_uint(out, i, size, pos->fullmove);
+#undef CC_PUT
+    out[i] = '\0';
+}
+
+// ---------- Moves ----------
+// Fill mv from a UCI string ("e2e4", "e7e8q") and classify it against pos without applying
+// it. Fails only if the squares are bad or nothing stands on the from square. A pawn
+// reaching the last rank without a promotion letter (ATmega payloads drop it) becomes a queen.
+bool cc_parse_uci(const cc_position_t* pos, const char* uci, cc_move_t* mv) {
+    memset(mv, 0, sizeof(*mv));
+    mv->from = cc_parse_square(uci);
+    mv->to = cc_parse_square(uci + 2);
+    mv->capture_sq = mv->rook_from = mv->rook_to = CC_NO_SQUARE;
+    if (mv->from == CC_NO_SQUARE || mv->to == CC_NO_SQUARE || mv->from == mv->to) return false;
+    mv->piece = cc_piece_at(pos, mv->from);
+    if (!mv->piece) return false;
+
+    uint8_t us = CC_COLOR(mv->piece);
+    uint8_t type = CC_TYPE(mv->piece);
+    int8_t df = (int8_t)(CC_FILE(mv->to) - CC_FILE(mv->from));
+    int8_t dr = (int8_t)(CC_RANK(mv->to) - CC_RANK(mv->from));
+
+    uint8_t target = cc_piece_at(pos, mv->to);
+    if (target) {
+        if (CC_COLOR(target) == us) return false;
+        mv->captured = target;
+        mv->capture_sq = mv->to;
+        mv->flags |= CC_MOVE_CAPTURE;
+    }
+
+    if (type == CC_PAWN) {
+        if (df != 0 && !target) {
+            // diagonal step onto an empty square: the pawn beside us is taken
+            uint8_t ep_sq = CC_SQUARE(CC_FILE(mv->to), CC_RANK(mv->from));
+            uint8_t victim = cc_piece_at(pos, ep_sq);
+            if (victim == CC_PIECE(us ^ 1, CC_PAWN)) {
+                mv->captured = victim;
+                mv->capture_sq = ep_sq;
+                mv->flags |= CC_MOVE_CAPTURE | CC_MOVE_EN_PASSANT;
+            }
+        }
+        if (df == 0 && (dr == 2 || dr == -2)) mv->flags |= CC_MOVE_DOUBLE_PUSH;
+        if (CC_RANK(mv->to) == (us == CC_WHITE ? 7 : 0)) {
+            uint8_t promo = CC_QUEEN;
+            if (uci[4]) {
+                uint8_t p = piece_from_char(uci[4]);
+                if (!p || CC_TYPE(p) == CC_PAWN || CC_TYPE(p) == CC_KING) return false;
+                promo = CC_TYPE(p);
+            }
+            mv->promo = CC_PIECE(us, promo);
+            mv->flags |= CC_MOVE_PROMOTION;
+        }
+    } else if (type == CC_KING && dr == 0 && (df == 2 || df == -2)) {
+        uint8_t rank = CC_RANK(mv->from);
+        mv->flags |= CC_MOVE_CASTLE;
+        mv->rook_from = CC_SQUARE(df > 0 ? 7 : 0, rank);
+        mv->rook_to = CC_SQUARE(df > 0 ? 5 : 3, rank);
+    }
+    return true;
+}
+
+// Squares strictly between a and b on a shared rank, file or diagonal are empty.
+// False if they are not aligned.
+static bool path_clear(uint64_t occ, uint8_t a, uint8_t b, bool straight, bool diagonal) {
+    int8_t df = (int8_t)(CC_FILE(b) - CC_FILE(a));
+    int8_t dr = (int8_t)(CC_RANK(b) - CC_RANK(a));
+    bool is_straight = (df == 0 || dr == 0);
+    bool is_diagonal = (df == dr || df == -dr);
+    if (!((straight && is_straight) || (diagonal && is_diagonal))) return false;
+    int8_t step = (int8_t)((df > 0 ? 8 : (df < 0 ? -8 : 0)) + (dr > 0 ? 1 : (dr < 0 ? -1 : 0)));
+    for (uint8_t sq = (uint8_t)(a + step); sq != b; sq = (uint8_t)(sq + step)) {
+        if (occ & CC_BB(sq)) return false;
+    }
+    return true;
+}
+
+// Move shape, blockers and side to move; does not look at checks
+bool cc_is_pseudo_legal(const cc_position_t* pos, const cc_move_t* mv) {
+    uint8_t us = CC_COLOR(mv->piece);
+    if (us != pos->side) return false;
+    uint64_t occ = cc_occupancy(pos);
+    uint64_t to_bb = CC_BB(mv->to);
+    int8_t df = (int8_t)(CC_FILE(mv->to) - CC_FILE(mv->from));
+    int8_t dr = (int8_t)(CC_RANK(mv->to) - CC_RANK(mv->from));
+
+    switch (CC_TYPE(mv->piece)) {
+        case CC_PAWN: {
+            int8_t fwd = us == CC_WHITE ? 1 : -1;
+            if (df == 0) {
+                if (mv->flags & CC_MOVE_CAPTURE) return false;
+                if (dr == fwd) return true;
+                uint8_t start_rank = us == CC_WHITE ? 1 : 6;
+                return dr == 2 * fwd && CC_RANK(mv->from) == start_rank &&
+                       !(occ & CC_BB(mv->from + fwd));
+            }
+            if ((df != 1 && df != -1) || dr != fwd) return false;
+            if (mv->flags & CC_MOVE_EN_PASSANT) return mv->to == pos->ep;
+            return (mv->flags & CC_MOVE_CAPTURE) != 0;
+        }
+        case CC_KNIGHT:
+            return (cc_read_bb(&knight_attacks[mv->from]) & to_bb) != 0;
+        case CC_BISHOP:
+            return path_clear(occ, mv->from, mv->to, false, true);
+        case CC_ROOK:
+            return path_clear(occ, mv->from, mv->to, true, false);
+        case CC_QUEEN:
+            return path_clear(occ, mv->from, mv->to, true, true);
+        case CC_KING:
+            if (mv->flags & CC_MOVE_CASTLE) {
+                uint8_t right = us == CC_WHITE ? (df > 0 ? CC_CASTLE_WK : CC_CASTLE_WQ)
+                                               : (df > 0 ? CC_CASTLE_BK : CC_CASTLE_BQ);
+                return (pos->castling & right) && !(occ & to_bb) &&
+                       cc_piece_at(pos, mv->rook_from) == CC_PIECE(us, CC_ROOK) &&
+                       path_clear(occ, mv->from, mv->rook_from, true, false);
+            }
+            return (cc_read_bb(&king_attacks[mv->from]) & to_bb) != 0;
+    }
+    return false;
+}
+
+void cc_apply(cc_position_t* pos, cc_move_t* mv) {
+    uint8_t us = CC_COLOR(mv->piece);
+    mv->prev_castling = pos->castling;
+    mv->prev_ep = pos->ep;
+    mv->prev_halfmove = pos->halfmove;
+
+    if (mv->captured) remove_piece(pos, mv->capture_sq, mv->captured);
+    remove_piece(pos, mv->from, mv->piece);
+    put_piece(pos, mv->to, mv->promo ? mv->promo : mv->piece);
+    if (mv->flags & CC_MOVE_CASTLE) {
+        uint8_t rook = CC_PIECE(us, CC_ROOK);
+        remove_piece(pos, mv->rook_from, rook);
+        put_piece(pos, mv->rook_to, rook);
+    }
+
+    pos->castling &= cc_read_u8(&castle_keep[mv->from]) & cc_read_u8(&castle_keep[mv->to]);
+    pos->ep = (mv->flags & CC_MOVE_DOUBLE_PUSH)
+              ? CC_SQUARE(CC_FILE(mv->from), (CC_RANK(mv->from) + CC_RANK(mv->to)) / 2)
+              : CC_NO_SQUARE;
+    if (CC_TYPE(mv->piece) == CC_PAWN || mv->captured) pos->halfmove = 0;
+    else if (pos->halfmove < 255) pos->halfmove++;
+    if (us == CC_BLACK) pos->fullmove++;
+    pos->side = us ^ 1;
+}
+
+void cc_undo(cc_position_t* pos, const cc_move_t* mv) {
+    uint8_t us = CC_COLOR(mv->piece);
+    if (mv->flags & CC_MOVE_CASTLE) {
+        uint8_t rook = CC_PIECE(us, CC_ROOK);
+        remove_piece(pos, mv->rook_to, rook);
+        put_piece(pos, mv->rook_from, rook);
+    }
+    remove_piece(pos, mv->to, mv->promo ? mv->promo : mv->piece);
+    put_piece(pos, mv->from, mv->piece);
+    if (mv->captured) put_piece(pos, mv->capture_sq, mv->captured);
+
+    pos->castling = mv->prev_castling;
+    pos->ep = mv->prev_ep;
+    pos->halfmove = mv->prev_halfmove;
+    if (us == CC_BLACK) pos->fullmove--;
+    pos->side = us;
+}
+
+bool cc_apply_uci(cc_position_t* pos, const char* uci, cc_move_t* mv) {
+    if (!cc_parse_uci(pos, uci, mv)) return false;
+    cc_apply(pos, mv);
+    return true;
+}
+
+void cc_move_to_uci(const cc_move_t* mv, char out[6]) {
+    cc_square_name(mv->from, out);
+    cc_square_name(mv->to, out + 2);
+    if (mv->promo) {
+        out[4] = piece_chars[CC_TYPE(mv->promo)];
+        out[5] = '\0';
+    }
+}
+
+// ---------- Legality ----------
+// Can a piece of colour `by` take on sq? Pseudo-legal, like cc_is_pseudo_legal()
+static bool square_attacked(const cc_position_t* pos, uint8_t sq, uint8_t by) {
+    // pawns take diagonally whether or not sq is occupied, which cc_parse_uci() can't tell
+    int8_t pawn_rank = (int8_t)CC_RANK(sq) - (by == CC_WHITE ? 1 : -1);
+    for (int8_t df = -1; df <= 1; df += 2) {
+        int8_t f = (int8_t)CC_FILE(sq) + df;
+        if (f >= 0 && f < 8 && pawn_rank >= 0 && pawn_rank < 8 &&
+            cc_piece_at(pos, CC_SQUARE(f, pawn_rank)) == CC_PIECE(by, CC_PAWN)) {
+            return true;
+        }
+    }
+    cc_position_t p = *pos;
+    p.side = by;
+    char uci[5];
+    for (uint8_t from = 0; from < 64; from++) {
+        if (!(p.color[by] & CC_BB(from)) || (p.type[CC_PAWN - 1] & CC_BB(from))) continue;
+        cc_move_t mv;
+        cc_square_name(from, uci);
+        cc_square_name(sq, uci + 2);
+        if (cc_parse_uci(&p, uci, &mv) && !(mv.flags & CC_MOVE_CASTLE) && cc_is_pseudo_legal(&p, &mv)) return true;
+    }
+    return false;
+}
+
+static bool leaves_king_attacked(const cc_position_t* pos, const cc_move_t* mv) {
+    cc_position_t p = *pos;
+    cc_move_t m = *mv;
+    uint8_t us = pos->side;
+    cc_apply(&p, &m);
+    uint64_t king = p.color[us] & p.type[CC_KING - 1];
+    for (uint8_t sq = 0; sq < 64; sq++) {
+        if (king & CC_BB(sq)) return square_attacked(&p, sq, us ^ 1);
+    }
+    return false;
+}
+
+// Pseudo-legal and doesn't leave the mover's king attacked; a castle may not start from
+// or pass through an attacked square either
+bool cc_is_legal(const cc_position_t* pos, const cc_move_t* mv) {
+    if (!cc_is_pseudo_legal(pos, mv)) return false;
+    if (mv->flags & CC_MOVE_CASTLE) {
+        uint8_t them = pos->side ^ 1;
+        if (square_attacked(pos, mv->from, them) || square_attacked(pos, (uint8_t)((mv->from + mv->to) / 2), them)) {
+            return false;
+        }
+    }
+    return !leaves_king_attacked(pos, mv);
+}
+
+// Every legal move of the side to move, the first max of them into moves. Returns how
+// many there are. Tries each from/to pair through cc_parse_uci(), so it is for tools and
+// tests, not for a search.
+size_t cc_generate_moves(const cc_position_t* pos, cc_move_t* moves, size_t max) {
+    static const char promos[] = "qrbn";
+    uint8_t last_rank = pos->side == CC_WHITE ? 7 : 0;
+    size_t n = 0;
+    char uci[6];
+    for (uint8_t from = 0; from < 64; from++) {
+        if (!(pos->color[pos->side] & CC_BB(from))) continue;
+        bool pawn = (pos->type[CC_PAWN - 1] & CC_BB(from)) != 0;
+        for (uint8_t to = 0; to < 64; to++) {
+            uint8_t kinds = pawn && CC_RANK(to) == last_rank ? 4 : 1;
+            for (uint8_t k = 0; k < kinds; k++) {
+                cc_move_t mv;
+                cc_square_name(from, uci);
+                cc_square_name(to, uci + 2);
+                uci[4] = kinds > 1 ? promos[k] : '\0';
+                uci[5] = '\0';
+                if (!cc_parse_uci(pos, uci, &mv) || !cc_is_legal(pos, &mv)) continue;
+                if (n < max) moves[n] = mv;
+                n++;
+            }
+        }
+    }
+    return n;
+}
+
+// ---------- Move lists ----------
+// Standard algebraic notation ("Nbd7", "exd6", "e8=Q+", "O-O") for the side to move.
+// Check / annotation marks are ignored; false if the move is illegal or ambiguous.
+bool cc_parse_san(const cc_position_t* pos, const char* san, cc_move_t* mv) {
+    char s[8];
+    size_t n = 0;
+    for (; *san && n < sizeof(s) - 1; san++) {
+        if (*san == 'x' || *san == '+' || *san == '#' || *san == '!' || *san == '?' || *san == '=') continue;
+        s[n++] = *san;
+    }
+    s[n] = '\0';
+    if (*san || n < 2) return false;
+
+    uint8_t us = pos->side;
+    uint8_t back = us == CC_WHITE ? 0 : 7;
+    if (strcmp(s, "O-O") == 0 || strcmp(s, "0-0") == 0 || strcmp(s, "O-O-O") == 0 || strcmp(s, "0-0-0") == 0) {
+        char uci[5];
+        cc_square_name(CC_SQUARE(4, back), uci);
+        cc_square_name(CC_SQUARE(n == 3 ? 6 : 2, back), uci + 2);
+        return cc_parse_uci(pos, uci, mv) && (mv->flags & CC_MOVE_CASTLE) && cc_is_legal(pos, mv);
+    }
+
+    uint8_t type = CC_PAWN;
+    const char* p = s;
+    if (*p >= 'A' && *p <= 'Z') {
+        uint8_t pc = piece_from_char(*p++);
+        if (!pc || CC_TYPE(pc) == CC_PAWN) return false;
+        type = CC_TYPE(pc);
+    }
+    char promo = 0;
+    size_t len = strlen(p);
+    if (len && p[len - 1] >= 'A' && p[len - 1] <= 'Z') {
+        promo = (char)(p[len - 1] - 'A' + 'a');
+        len--;
+    }
+    if (len < 2) return false;
+    uint8_t to = cc_parse_square(p + len - 2);
+    if (to == CC_NO_SQUARE) return false;
+    int8_t want_file = -1, want_rank = -1;
+    for (size_t i = 0; i + 2 < len; i++) {
+        if (p[i] >= 'a' && p[i] <= 'h') want_file = (int8_t)(p[i] - 'a');
+        else if (p[i] >= '1' && p[i] <= '8') want_rank = (int8_t)(p[i] - '1');
+        else return false;
+    }
+
+    char uci[6];
+    bool found = false;
+    for (uint8_t from = 0; from < 64; from++) {
+        if (cc_piece_at(pos, from) != CC_PIECE(us, type)) continue;
+        if ((want_file >= 0 && CC_FILE(from) != want_file) || (want_rank >= 0 && CC_RANK(from) != want_rank)) continue;
+        cc_move_t cand;
+        cc_square_name(from, uci);
+        cc_square_name(to, uci + 2);
+        uci[4] = promo;
+        uci[5] = '\0';
+        if (!cc_parse_uci(pos, uci, &cand) || (cand.flags & CC_MOVE_CASTLE) || !cc_is_legal(pos, &cand)) continue;
+        if (found) return false;
+        *mv = cand;
+        found = true;
+    }
+    return found;
+}
+
+// Next move token of a PGN or a plain UCI list, copied to out; NULL at the end. Tag pairs,
+// comments, variations, move numbers, NAGs and the result are skipped.
+const char* cc_next_move_token(const char* text, char* out, size_t size) {
+    for (;;) {
+        while (*text == ' ' || *text == '\t' || *text == '\r' || *text == '\n') text++;
+        if (!*text) return NULL;
+        if (*text == '(') {
+            // variations nest
+            unsigned depth = 0;
+            do {
+                if (*text == '(') depth++;
+                else if (*text == ')') depth--;
+                else if (!*text) return NULL;
+                text++;
+            } while (depth);
+            continue;
+        }
+        char close = *text == '[' ? ']' : *text == '{' ? '}' : 0;
+        if (close) {
+            const char* end = strchr(text, close);
+            if (!end) return NULL;
+            text = end + 1;
+            continue;
+        }
+        if (*text == ';') {
+            // comment to the end of the line
+            while (*text && *text != '\n') text++;
+            continue;
+        }
+        size_t n = strcspn(text, " \t\r\n{(;");
+        const char* tok = text;
+        text += n;
+        if (*tok == '$' || *tok == '*' || (n == 3 && strncmp(tok, "1-0", 3) == 0) ||
+            (n == 3 && strncmp(tok, "0-1", 3) == 0) || (n == 7 && strncmp(tok, "1/2-1/2", 7) == 0)) {
+            continue;
+        }
+        // move number, on its own ("12." / "12...") or in front of the move ("12.e4")
+        size_t digits = 0;
+        while (digits < n && tok[digits] >= '0' && tok[digits] <= '9') digits++;
+        if (digits && digits < n && tok[digits] == '.') {
+            tok += digits;
+            n -= digits;
+            while (n && *tok == '.') {
+                tok++;
+                n--;
+            }
+        }
+        if (!n || n >= size) continue;
+        memcpy(out, tok, n);
+        out[n] = '\0';
+        return text;
+    }
+}
+
+// One token: UCI if it reads as one, SAN otherwise
+bool cc_parse_move(const cc_position_t* pos, const char* token, cc_move_t* mv) {
+    size_t n = strlen(token);
+    if ((n == 4 || n == 5) && cc_parse_square(token) != CC_NO_SQUARE && cc_parse_square(token + 2) != CC_NO_SQUARE) {
+        return cc_parse_uci(pos, token, mv) && cc_is_pseudo_legal(pos, mv);
+    }
+    return cc_parse_san(pos, token, mv);
+}
@@ -0,0 +1,108 @@
+#ifndef CHESS_CORE_H
+#define CHESS_CORE_H
+
+/*
+  Portable chess position shared by the ATmega firmware (chess.X) and the ESP32 bridge.
+  Plain C99, no allocation. Lookup tables are constant initialisers built by macros, kept
+  in flash (PROGMEM) on AVR.
+
+  Squares are numbered file-major: sq = file * 8 + rank, a1 = 0, a8 = 7, h8 = 63. Byte f of
+  an occupancy bitboard is then the MCP23008 column byte for file f (bit r = rank r + 1).
+
+  host/chess_core_test.c checks it natively, perft counts included.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CC_NO_SQUARE 64
+#define CC_SQUARE(file, rank) ((uint8_t)((file) * 8 + (rank)))
+#define CC_FILE(sq) ((uint8_t)((sq) >> 3))
+#define CC_RANK(sq) ((uint8_t)((sq) & 7))
+#define CC_BB(sq) ((uint64_t)1 << (sq))
+
+#define CC_WHITE 0
+#define CC_BLACK 1
+
+// Piece codes: type | colour << 3, 0 = empty square
+#define CC_PAWN   1
+#define CC_KNIGHT 2
+#define CC_BISHOP 3
+#define CC_ROOK   4
+#define CC_QUEEN  5
+#define CC_KING   6
+#define CC_PIECE(color, type) ((uint8_t)((type) | ((color) << 3)))
+#define CC_TYPE(p) ((uint8_t)((p) & 7))
+#define CC_COLOR(p) ((uint8_t)((p) >> 3))
+
+// Castling rights
+#define CC_CASTLE_WK 0x01
+#define CC_CASTLE_WQ 0x02
+#define CC_CASTLE_BK 0x04
+#define CC_CASTLE_BQ 0x08
+
+// Move classification flags
+#define CC_MOVE_CAPTURE     0x01
+#define CC_MOVE_EN_PASSANT  0x02
+#define CC_MOVE_CASTLE      0x04
+#define CC_MOVE_PROMOTION   0x08
+#define CC_MOVE_DOUBLE_PUSH 0x10
+
+// Longest FEN written by cc_to_fen(), terminator included
+#define CC_FEN_MAX 92
+
+typedef struct {
+    uint64_t color[2];      // occupancy per colour
+    uint64_t type[6];       // occupancy per piece type, index type - 1
+    uint8_t side;           // side to move
+    uint8_t castling;       // CC_CASTLE_* rights
+    uint8_t ep;             // en passant target square, CC_NO_SQUARE if none
+    uint8_t halfmove;
+    uint16_t fullmove;
+} cc_position_t;
+
+// A parsed move with everything needed to undo it
+typedef struct {
+    uint8_t from, to;
+    uint8_t piece;          // moving piece
+    uint8_t promo;          // piece it becomes, 0 if not a promotion
+    uint8_t flags;          // CC_MOVE_*
+    uint8_t captured;       // captured piece, 0 if none
+    uint8_t capture_sq;     // square it was taken on (differs from to for en passant)
+    uint8_t rook_from, rook_to;
+    uint8_t prev_castling, prev_ep, prev_halfmove;
+} cc_move_t;
+
+void cc_position_start(cc_position_t* pos);
+bool cc_from_fen(cc_position_t* pos, const char* fen);
+void cc_to_fen(const cc_position_t* pos, char* out, size_t size);
+
+uint8_t cc_piece_at(const cc_position_t* pos, uint8_t sq);
+uint64_t cc_occupancy(const cc_position_t* pos);
+uint8_t cc_parse_square(const char* s);
+void cc_square_name(uint8_t sq, char out[3]);
+
+bool cc_parse_uci(const cc_position_t* pos, const char* uci, cc_move_t* mv);
+bool cc_is_pseudo_legal(const cc_position_t* pos, const cc_move_t* mv);
+void cc_apply(cc_position_t* pos, cc_move_t* mv);
+void cc_undo(cc_position_t* pos, const cc_move_t* mv);
+bool cc_apply_uci(cc_position_t* pos, const char* uci, cc_move_t* mv);
+void cc_move_to_uci(const cc_move_t* mv, char out[6]);
+bool cc_is_legal(const cc_position_t* pos, const cc_move_t* mv);
+size_t cc_generate_moves(const cc_position_t* pos, cc_move_t* moves, size_t max);
+
+// Move lists: PGN movetext or space-separated UCI
+bool cc_parse_san(const cc_position_t* pos, const char* san, cc_move_t* mv);
+bool cc_parse_move(const cc_position_t* pos, const char* token, cc_move_t* mv);
+const char* cc_next_move_token(const char* text, char* out, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -51,17 +51,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../main.c ../avr-print/uart.c ../src/i2c.c ../src/steppermotor.c ../src/uart_esp.c
+SOURCEFILES_QUOTED_IF_SPACED=../main.c ../avr-print/uart.c ../src/i2c.c ../src/steppermotor.c ../src/uart_esp.c ../src/trace.c ../src/gantry_plan.c ../src/checkpoint.c ../src/placement.c ../src/stepgen.c ../src/calibrate.c ../src/magnet.c ../src/sensors.c ../src/profile.c ../src/sram.c ../src/move_detect.c ../src/recorder.c ../src/idle.c ../ESP32_lichess/src/chess_core/chess_core.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1472/main.o ${OBJECTDIR}/_ext/303529426/uart.o ${OBJECTDIR}/_ext/1360937237/i2c.o ${OBJECTDIR}/_ext/1360937237/steppermotor.o ${OBJECTDIR}/_ext/1360937237/uart_esp.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1472/main.o.d ${OBJECTDIR}/_ext/303529426/uart.o.d ${OBJECTDIR}/_ext/1360937237/i2c.o.d ${OBJECTDIR}/_ext/1360937237/steppermotor.o.d ${OBJECTDIR}/_ext/1360937237/uart_esp.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1472/main.o ${OBJECTDIR}/_ext/303529426/uart.o ${OBJECTDIR}/_ext/1360937237/i2c.o ${OBJECTDIR}/_ext/1360937237/steppermotor.o ${OBJECTDIR}/_ext/1360937237/uart_esp.o ${OBJECTDIR}/_ext/1360937237/trace.o ${OBJECTDIR}/_ext/1360937237/gantry_plan.o ${OBJECTDIR}/_ext/1360937237/checkpoint.o ${OBJECTDIR}/_ext/1360937237/placement.o ${OBJECTDIR}/_ext/1360937237/stepgen.o ${OBJECTDIR}/_ext/1360937237/calibrate.o ${OBJECTDIR}/_ext/1360937237/magnet.o ${OBJECTDIR}/_ext/1360937237/sensors.o ${OBJECTDIR}/_ext/1360937237/profile.o ${OBJECTDIR}/_ext/1360937237/sram.o ${OBJECTDIR}/_ext/1360937237/move_detect.o ${OBJECTDIR}/_ext/1360937237/recorder.o ${OBJECTDIR}/_ext/1360937237/idle.o ${OBJECTDIR}/_ext/2117234910/chess_core.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1472/main.o.d ${OBJECTDIR}/_ext/303529426/uart.o.d ${OBJECTDIR}/_ext/1360937237/i2c.o.d ${OBJECTDIR}/_ext/1360937237/steppermotor.o.d ${OBJECTDIR}/_ext/1360937237/uart_esp.o.d ${OBJECTDIR}/_ext/1360937237/trace.o.d ${OBJECTDIR}/_ext/1360937237/gantry_plan.o.d ${OBJECTDIR}/_ext/1360937237/checkpoint.o.d ${OBJECTDIR}/_ext/1360937237/placement.o.d ${OBJECTDIR}/_ext/1360937237/stepgen.o.d ${OBJECTDIR}/_ext/1360937237/calibrate.o.d ${OBJECTDIR}/_ext/1360937237/magnet.o.d ${OBJECTDIR}/_ext/1360937237/sensors.o.d ${OBJECTDIR}/_ext/1360937237/profile.o.d ${OBJECTDIR}/_ext/1360937237/sram.o.d ${OBJECTDIR}/_ext/1360937237/move_detect.o.d ${OBJECTDIR}/_ext/1360937237/recorder.o.d ${OBJECTDIR}/_ext/1360937237/idle.o.d ${OBJECTDIR}/_ext/2117234910/chess_core.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/1472/main.o ${OBJECTDIR}/_ext/303529426/uart.o ${OBJECTDIR}/_ext/1360937237/i2c.o ${OBJECTDIR}/_ext/1360937237/steppermotor.o ${OBJECTDIR}/_ext/1360937237/uart_esp.o
+OBJECTFILES=${OBJECTDIR}/_ext/1472/main.o ${OBJECTDIR}/_ext/303529426/uart.o ${OBJECTDIR}/_ext/1360937237/i2c.o ${OBJECTDIR}/_ext/1360937237/steppermotor.o ${OBJECTDIR}/_ext/1360937237/uart_esp.o ${OBJECTDIR}/_ext/1360937237/trace.o ${OBJECTDIR}/_ext/1360937237/gantry_plan.o ${OBJECTDIR}/_ext/1360937237/checkpoint.o ${OBJECTDIR}/_ext/1360937237/placement.o ${OBJECTDIR}/_ext/1360937237/stepgen.o ${OBJECTDIR}/_ext/1360937237/calibrate.o ${OBJECTDIR}/_ext/1360937237/magnet.o ${OBJECTDIR}/_ext/1360937237/sensors.o ${OBJECTDIR}/_ext/1360937237/profile.o ${OBJECTDIR}/_ext/1360937237/sram.o ${OBJECTDIR}/_ext/1360937237/move_detect.o ${OBJECTDIR}/_ext/1360937237/recorder.o ${OBJECTDIR}/_ext/1360937237/idle.o ${OBJECTDIR}/_ext/2117234910/chess_core.o
 
 # Source Files
-SOURCEFILES=../main.c ../avr-print/uart.c ../src/i2c.c ../src/steppermotor.c ../src/uart_esp.c
+SOURCEFILES=../main.c ../avr-print/uart.c ../src/i2c.c ../src/steppermotor.c ../src/uart_esp.c ../src/trace.c ../src/gantry_plan.c ../src/checkpoint.c ../src/placement.c ../src/stepgen.c ../src/calibrate.c ../src/magnet.c ../src/sensors.c ../src/profile.c ../src/sram.c ../src/move_detect.c ../src/recorder.c ../src/idle.c ../ESP32_lichess/src/chess_core/chess_core.c
 
 
 
@@ -88,66 +88,234 @@ MP_PROCESSOR_OPTION=ATmega328PB
 # ------------------------------------------------------------------------------------
 # Rules for buildStep: compile
 ifeq ($(TYPE_IMAGE), DEBUG_RUN)
-${OBJECTDIR}/_ext/1472/main.o: ../main.c  .generated_files/flags/default/1f3161c40de32ed1606643f16ba71dab5b9b2b4f .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+${OBJECTDIR}/_ext/1472/main.o: ../main.c  .generated_files/flags/default/5597ec07fe8fa78e1e78b78c6a63d4f69af2adb8 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
 	@${RM} ${OBJECTDIR}/_ext/1472/main.o.d 
 	@${RM} ${OBJECTDIR}/_ext/1472/main.o 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1472/main.o.d" -MT "${OBJECTDIR}/_ext/1472/main.o.d" -MT ${OBJECTDIR}/_ext/1472/main.o -o ${OBJECTDIR}/_ext/1472/main.o ../main.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1472/main.o.d" -MT "${OBJECTDIR}/_ext/1472/main.o.d" -MT ${OBJECTDIR}/_ext/1472/main.o -o ${OBJECTDIR}/_ext/1472/main.o ../main.c 
 	
-${OBJECTDIR}/_ext/303529426/uart.o: ../avr-print/uart.c  .generated_files/flags/default/1887987fc4d4cc28da3a8fc8340908886f730de0 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+${OBJECTDIR}/_ext/303529426/uart.o: ../avr-print/uart.c  .generated_files/flags/default/999ca5fd026eb90726c0c7eec28606765122274a .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/303529426" 
 	@${RM} ${OBJECTDIR}/_ext/303529426/uart.o.d 
 	@${RM} ${OBJECTDIR}/_ext/303529426/uart.o 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/303529426/uart.o.d" -MT "${OBJECTDIR}/_ext/303529426/uart.o.d" -MT ${OBJECTDIR}/_ext/303529426/uart.o -o ${OBJECTDIR}/_ext/303529426/uart.o ../avr-print/uart.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/303529426/uart.o.d" -MT "${OBJECTDIR}/_ext/303529426/uart.o.d" -MT ${OBJECTDIR}/_ext/303529426/uart.o -o ${OBJECTDIR}/_ext/303529426/uart.o ../avr-print/uart.c 
 	
-${OBJECTDIR}/_ext/1360937237/i2c.o: ../src/i2c.c  .generated_files/flags/default/4a0e68eb13721e656d9ca6b933e895071126e9e5 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+${OBJECTDIR}/_ext/1360937237/i2c.o: ../src/i2c.c  .generated_files/flags/default/3357798b60f73a37b37c27439b6dc8718eff7541 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/i2c.o.d 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/i2c.o 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/i2c.o.d" -MT "${OBJECTDIR}/_ext/1360937237/i2c.o.d" -MT ${OBJECTDIR}/_ext/1360937237/i2c.o -o ${OBJECTDIR}/_ext/1360937237/i2c.o ../src/i2c.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/i2c.o.d" -MT "${OBJECTDIR}/_ext/1360937237/i2c.o.d" -MT ${OBJECTDIR}/_ext/1360937237/i2c.o -o ${OBJECTDIR}/_ext/1360937237/i2c.o ../src/i2c.c 
 	
-${OBJECTDIR}/_ext/1360937237/steppermotor.o: ../src/steppermotor.c  .generated_files/flags/default/3d2ca4e9da9fcc402d9408eba40766ce2954f5f9 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+${OBJECTDIR}/_ext/1360937237/steppermotor.o: ../src/steppermotor.c  .generated_files/flags/default/30fb4b3852a55a57cb4e8a8de898b2291ef3ec53 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/steppermotor.o.d 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/steppermotor.o 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/steppermotor.o.d" -MT "${OBJECTDIR}/_ext/1360937237/steppermotor.o.d" -MT ${OBJECTDIR}/_ext/1360937237/steppermotor.o -o ${OBJECTDIR}/_ext/1360937237/steppermotor.o ../src/steppermotor.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/steppermotor.o.d" -MT "${OBJECTDIR}/_ext/1360937237/steppermotor.o.d" -MT ${OBJECTDIR}/_ext/1360937237/steppermotor.o -o ${OBJECTDIR}/_ext/1360937237/steppermotor.o ../src/steppermotor.c 
 	
-${OBJECTDIR}/_ext/1360937237/uart_esp.o: ../src/uart_esp.c  .generated_files/flags/default/d1f3ddb11dfb7d89d08a39ae7ad52bca0ed62279 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+${OBJECTDIR}/_ext/1360937237/uart_esp.o: ../src/uart_esp.c  .generated_files/flags/default/4ea21410474f1213608d88acd25aafdcc92e3d6e .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/uart_esp.o.d 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/uart_esp.o 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/uart_esp.o.d" -MT "${OBJECTDIR}/_ext/1360937237/uart_esp.o.d" -MT ${OBJECTDIR}/_ext/1360937237/uart_esp.o -o ${OBJECTDIR}/_ext/1360937237/uart_esp.o ../src/uart_esp.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/uart_esp.o.d" -MT "${OBJECTDIR}/_ext/1360937237/uart_esp.o.d" -MT ${OBJECTDIR}/_ext/1360937237/uart_esp.o -o ${OBJECTDIR}/_ext/1360937237/uart_esp.o ../src/uart_esp.c 
+	
+${OBJECTDIR}/_ext/1360937237/trace.o: ../src/trace.c  .generated_files/flags/default/8ec25df0e77096b301e1cad6778a32bf54e6124f .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/trace.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/trace.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/trace.o.d" -MT "${OBJECTDIR}/_ext/1360937237/trace.o.d" -MT ${OBJECTDIR}/_ext/1360937237/trace.o -o ${OBJECTDIR}/_ext/1360937237/trace.o ../src/trace.c 
+	
+${OBJECTDIR}/_ext/1360937237/gantry_plan.o: ../src/gantry_plan.c  .generated_files/flags/default/f21394183511b4b90f76a56feb55507b35b2b725 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/gantry_plan.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/gantry_plan.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/gantry_plan.o.d" -MT "${OBJECTDIR}/_ext/1360937237/gantry_plan.o.d" -MT ${OBJECTDIR}/_ext/1360937237/gantry_plan.o -o ${OBJECTDIR}/_ext/1360937237/gantry_plan.o ../src/gantry_plan.c 
+	
+${OBJECTDIR}/_ext/1360937237/checkpoint.o: ../src/checkpoint.c  .generated_files/flags/default/b0edb1cd18ba062634e97f22d8f42207502884ad .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/checkpoint.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/checkpoint.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/checkpoint.o.d" -MT "${OBJECTDIR}/_ext/1360937237/checkpoint.o.d" -MT ${OBJECTDIR}/_ext/1360937237/checkpoint.o -o ${OBJECTDIR}/_ext/1360937237/checkpoint.o ../src/checkpoint.c 
+	
+${OBJECTDIR}/_ext/1360937237/placement.o: ../src/placement.c  .generated_files/flags/default/44177b628d9719034b0ee9f638f1e65d50673361 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/placement.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/placement.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/placement.o.d" -MT "${OBJECTDIR}/_ext/1360937237/placement.o.d" -MT ${OBJECTDIR}/_ext/1360937237/placement.o -o ${OBJECTDIR}/_ext/1360937237/placement.o ../src/placement.c 
+	
+${OBJECTDIR}/_ext/1360937237/stepgen.o: ../src/stepgen.c  .generated_files/flags/default/eb03912462ed7fd21e6d2322ff58bcefe38dbd66 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/stepgen.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/stepgen.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/stepgen.o.d" -MT "${OBJECTDIR}/_ext/1360937237/stepgen.o.d" -MT ${OBJECTDIR}/_ext/1360937237/stepgen.o -o ${OBJECTDIR}/_ext/1360937237/stepgen.o ../src/stepgen.c 
+	
+${OBJECTDIR}/_ext/1360937237/calibrate.o: ../src/calibrate.c  .generated_files/flags/default/cca9c454810a9303223cba59887254d6222f2b4e .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/calibrate.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/calibrate.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/calibrate.o.d" -MT "${OBJECTDIR}/_ext/1360937237/calibrate.o.d" -MT ${OBJECTDIR}/_ext/1360937237/calibrate.o -o ${OBJECTDIR}/_ext/1360937237/calibrate.o ../src/calibrate.c 
+	
+${OBJECTDIR}/_ext/1360937237/magnet.o: ../src/magnet.c  .generated_files/flags/default/f32bd7fcd0a3e509129db8b3412d1a71b4a65682 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/magnet.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/magnet.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/magnet.o.d" -MT "${OBJECTDIR}/_ext/1360937237/magnet.o.d" -MT ${OBJECTDIR}/_ext/1360937237/magnet.o -o ${OBJECTDIR}/_ext/1360937237/magnet.o ../src/magnet.c 
+	
+${OBJECTDIR}/_ext/1360937237/sensors.o: ../src/sensors.c  .generated_files/flags/default/6fdf958790a0751a4ab1d8faf2753db91fb7b788 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/sensors.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/sensors.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/sensors.o.d" -MT "${OBJECTDIR}/_ext/1360937237/sensors.o.d" -MT ${OBJECTDIR}/_ext/1360937237/sensors.o -o ${OBJECTDIR}/_ext/1360937237/sensors.o ../src/sensors.c 
+	
+${OBJECTDIR}/_ext/1360937237/profile.o: ../src/profile.c  .generated_files/flags/default/b0baa5f0f0bf5b8221c5bbe3e26419be0e599325 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/profile.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/profile.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/profile.o.d" -MT "${OBJECTDIR}/_ext/1360937237/profile.o.d" -MT ${OBJECTDIR}/_ext/1360937237/profile.o -o ${OBJECTDIR}/_ext/1360937237/profile.o ../src/profile.c 
+	
+${OBJECTDIR}/_ext/1360937237/sram.o: ../src/sram.c  .generated_files/flags/default/98048a92653e8c9fe9aec236e2458eaa051d3998 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/sram.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/sram.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/sram.o.d" -MT "${OBJECTDIR}/_ext/1360937237/sram.o.d" -MT ${OBJECTDIR}/_ext/1360937237/sram.o -o ${OBJECTDIR}/_ext/1360937237/sram.o ../src/sram.c 
+	
+${OBJECTDIR}/_ext/1360937237/move_detect.o: ../src/move_detect.c  .generated_files/flags/default/2fae9694ef8a5833d2bfe3a06914f1fc23c709da .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/move_detect.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/move_detect.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/move_detect.o.d" -MT "${OBJECTDIR}/_ext/1360937237/move_detect.o.d" -MT ${OBJECTDIR}/_ext/1360937237/move_detect.o -o ${OBJECTDIR}/_ext/1360937237/move_detect.o ../src/move_detect.c 
+	
+${OBJECTDIR}/_ext/1360937237/recorder.o: ../src/recorder.c  .generated_files/flags/default/f7c31d2adcc8f75a2082f976681edecb5454b927 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/recorder.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/recorder.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/recorder.o.d" -MT "${OBJECTDIR}/_ext/1360937237/recorder.o.d" -MT ${OBJECTDIR}/_ext/1360937237/recorder.o -o ${OBJECTDIR}/_ext/1360937237/recorder.o ../src/recorder.c 
+	
+${OBJECTDIR}/_ext/1360937237/idle.o: ../src/idle.c  .generated_files/flags/default/7cd71c131f10c6ceb0022dcb09f3dec38af78967 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/idle.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/idle.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/idle.o.d" -MT "${OBJECTDIR}/_ext/1360937237/idle.o.d" -MT ${OBJECTDIR}/_ext/1360937237/idle.o -o ${OBJECTDIR}/_ext/1360937237/idle.o ../src/idle.c 
+	
+${OBJECTDIR}/_ext/2117234910/chess_core.o: ../ESP32_lichess/src/chess_core/chess_core.c  .generated_files/flags/default/4157e64ce9b999364a34906e030bf9d6f9fb4938 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/2117234910" 
+	@${RM} ${OBJECTDIR}/_ext/2117234910/chess_core.o.d 
+	@${RM} ${OBJECTDIR}/_ext/2117234910/chess_core.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -D__DEBUG=1 -g -DDEBUG  -gdwarf-2  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/2117234910/chess_core.o.d" -MT "${OBJECTDIR}/_ext/2117234910/chess_core.o.d" -MT ${OBJECTDIR}/_ext/2117234910/chess_core.o -o ${OBJECTDIR}/_ext/2117234910/chess_core.o ../ESP32_lichess/src/chess_core/chess_core.c 
 	
 else
-${OBJECTDIR}/_ext/1472/main.o: ../main.c  .generated_files/flags/default/3822b9a00cde50940ac406eca1732e27f11004cc .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+${OBJECTDIR}/_ext/1472/main.o: ../main.c  .generated_files/flags/default/b27afd4af3bd4a3a9d94f28f31a512e069f3a778 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/1472" 
 	@${RM} ${OBJECTDIR}/_ext/1472/main.o.d 
 	@${RM} ${OBJECTDIR}/_ext/1472/main.o 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1472/main.o.d" -MT "${OBJECTDIR}/_ext/1472/main.o.d" -MT ${OBJECTDIR}/_ext/1472/main.o -o ${OBJECTDIR}/_ext/1472/main.o ../main.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1472/main.o.d" -MT "${OBJECTDIR}/_ext/1472/main.o.d" -MT ${OBJECTDIR}/_ext/1472/main.o -o ${OBJECTDIR}/_ext/1472/main.o ../main.c 
 	
-${OBJECTDIR}/_ext/303529426/uart.o: ../avr-print/uart.c  .generated_files/flags/default/4a28761f3d09f36ee6092f812a535567e9d48484 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+${OBJECTDIR}/_ext/303529426/uart.o: ../avr-print/uart.c  .generated_files/flags/default/8c7f850cabe05f6ae37975259b2daf32cec31263 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/303529426" 
 	@${RM} ${OBJECTDIR}/_ext/303529426/uart.o.d 
 	@${RM} ${OBJECTDIR}/_ext/303529426/uart.o 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/303529426/uart.o.d" -MT "${OBJECTDIR}/_ext/303529426/uart.o.d" -MT ${OBJECTDIR}/_ext/303529426/uart.o -o ${OBJECTDIR}/_ext/303529426/uart.o ../avr-print/uart.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/303529426/uart.o.d" -MT "${OBJECTDIR}/_ext/303529426/uart.o.d" -MT ${OBJECTDIR}/_ext/303529426/uart.o -o ${OBJECTDIR}/_ext/303529426/uart.o ../avr-print/uart.c 
 	
-${OBJECTDIR}/_ext/1360937237/i2c.o: ../src/i2c.c  .generated_files/flags/default/fa6650307b9e6e0fbef0cbdb88fe5f356fdf2be9 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+${OBJECTDIR}/_ext/1360937237/i2c.o: ../src/i2c.c  .generated_files/flags/default/b001758ba820a219494488014fa412b2ce13210a .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/i2c.o.d 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/i2c.o 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/i2c.o.d" -MT "${OBJECTDIR}/_ext/1360937237/i2c.o.d" -MT ${OBJECTDIR}/_ext/1360937237/i2c.o -o ${OBJECTDIR}/_ext/1360937237/i2c.o ../src/i2c.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/i2c.o.d" -MT "${OBJECTDIR}/_ext/1360937237/i2c.o.d" -MT ${OBJECTDIR}/_ext/1360937237/i2c.o -o ${OBJECTDIR}/_ext/1360937237/i2c.o ../src/i2c.c 
 	
-${OBJECTDIR}/_ext/1360937237/steppermotor.o: ../src/steppermotor.c  .generated_files/flags/default/f562b97f1787bebe92efb6df2828ef1385183416 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+${OBJECTDIR}/_ext/1360937237/steppermotor.o: ../src/steppermotor.c  .generated_files/flags/default/8282c484af50e0547ce3371b7942e0e66ca1529e .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/steppermotor.o.d 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/steppermotor.o 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/steppermotor.o.d" -MT "${OBJECTDIR}/_ext/1360937237/steppermotor.o.d" -MT ${OBJECTDIR}/_ext/1360937237/steppermotor.o -o ${OBJECTDIR}/_ext/1360937237/steppermotor.o ../src/steppermotor.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/steppermotor.o.d" -MT "${OBJECTDIR}/_ext/1360937237/steppermotor.o.d" -MT ${OBJECTDIR}/_ext/1360937237/steppermotor.o -o ${OBJECTDIR}/_ext/1360937237/steppermotor.o ../src/steppermotor.c 
 	
-${OBJECTDIR}/_ext/1360937237/uart_esp.o: ../src/uart_esp.c  .generated_files/flags/default/740a1e498998490acd391619de3748e060cdc61e .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+${OBJECTDIR}/_ext/1360937237/uart_esp.o: ../src/uart_esp.c  .generated_files/flags/default/06d3139194128061458f326550a5361900cd1853 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
 	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/uart_esp.o.d 
 	@${RM} ${OBJECTDIR}/_ext/1360937237/uart_esp.o 
-	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/uart_esp.o.d" -MT "${OBJECTDIR}/_ext/1360937237/uart_esp.o.d" -MT ${OBJECTDIR}/_ext/1360937237/uart_esp.o -o ${OBJECTDIR}/_ext/1360937237/uart_esp.o ../src/uart_esp.c 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/uart_esp.o.d" -MT "${OBJECTDIR}/_ext/1360937237/uart_esp.o.d" -MT ${OBJECTDIR}/_ext/1360937237/uart_esp.o -o ${OBJECTDIR}/_ext/1360937237/uart_esp.o ../src/uart_esp.c 
+	
+${OBJECTDIR}/_ext/1360937237/trace.o: ../src/trace.c  .generated_files/flags/default/88b93cb4d05cd2a520a7027dd8f8aa1a266912a5 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/trace.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/trace.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/trace.o.d" -MT "${OBJECTDIR}/_ext/1360937237/trace.o.d" -MT ${OBJECTDIR}/_ext/1360937237/trace.o -o ${OBJECTDIR}/_ext/1360937237/trace.o ../src/trace.c 
+	
+${OBJECTDIR}/_ext/1360937237/gantry_plan.o: ../src/gantry_plan.c  .generated_files/flags/default/48f40c935a0728413a26bceb78d98a4ec4c7b41b .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/gantry_plan.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/gantry_plan.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/gantry_plan.o.d" -MT "${OBJECTDIR}/_ext/1360937237/gantry_plan.o.d" -MT ${OBJECTDIR}/_ext/1360937237/gantry_plan.o -o ${OBJECTDIR}/_ext/1360937237/gantry_plan.o ../src/gantry_plan.c 
+	
+${OBJECTDIR}/_ext/1360937237/checkpoint.o: ../src/checkpoint.c  .generated_files/flags/default/9e6a98ce1d9b87e9444deeae76e5895c8322b59b .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/checkpoint.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/checkpoint.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/checkpoint.o.d" -MT "${OBJECTDIR}/_ext/1360937237/checkpoint.o.d" -MT ${OBJECTDIR}/_ext/1360937237/checkpoint.o -o ${OBJECTDIR}/_ext/1360937237/checkpoint.o ../src/checkpoint.c 
+	
+${OBJECTDIR}/_ext/1360937237/placement.o: ../src/placement.c  .generated_files/flags/default/8b9a83a20cd42608c415098318ff1e1eed9264e8 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/placement.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/placement.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/placement.o.d" -MT "${OBJECTDIR}/_ext/1360937237/placement.o.d" -MT ${OBJECTDIR}/_ext/1360937237/placement.o -o ${OBJECTDIR}/_ext/1360937237/placement.o ../src/placement.c 
+	
+${OBJECTDIR}/_ext/1360937237/stepgen.o: ../src/stepgen.c  .generated_files/flags/default/8966cccd18658eb8cc8e1b00bfe312d13daa22e6 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/stepgen.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/stepgen.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/stepgen.o.d" -MT "${OBJECTDIR}/_ext/1360937237/stepgen.o.d" -MT ${OBJECTDIR}/_ext/1360937237/stepgen.o -o ${OBJECTDIR}/_ext/1360937237/stepgen.o ../src/stepgen.c 
+	
+${OBJECTDIR}/_ext/1360937237/calibrate.o: ../src/calibrate.c  .generated_files/flags/default/81e9d7b246831759b7dc75215f9447c63dc32e83 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/calibrate.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/calibrate.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/calibrate.o.d" -MT "${OBJECTDIR}/_ext/1360937237/calibrate.o.d" -MT ${OBJECTDIR}/_ext/1360937237/calibrate.o -o ${OBJECTDIR}/_ext/1360937237/calibrate.o ../src/calibrate.c 
+	
+${OBJECTDIR}/_ext/1360937237/magnet.o: ../src/magnet.c  .generated_files/flags/default/5f47172fcbea5fcad00d3e3168690831527da07b .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/magnet.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/magnet.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/magnet.o.d" -MT "${OBJECTDIR}/_ext/1360937237/magnet.o.d" -MT ${OBJECTDIR}/_ext/1360937237/magnet.o -o ${OBJECTDIR}/_ext/1360937237/magnet.o ../src/magnet.c 
+	
+${OBJECTDIR}/_ext/1360937237/sensors.o: ../src/sensors.c  .generated_files/flags/default/9693ddda0ae821d59c9cbd973541c73866645ce7 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/sensors.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/sensors.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/sensors.o.d" -MT "${OBJECTDIR}/_ext/1360937237/sensors.o.d" -MT ${OBJECTDIR}/_ext/1360937237/sensors.o -o ${OBJECTDIR}/_ext/1360937237/sensors.o ../src/sensors.c 
+	
+${OBJECTDIR}/_ext/1360937237/profile.o: ../src/profile.c  .generated_files/flags/default/ea880432713514ce42b8cfad426aaece5554082b .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/profile.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/profile.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/profile.o.d" -MT "${OBJECTDIR}/_ext/1360937237/profile.o.d" -MT ${OBJECTDIR}/_ext/1360937237/profile.o -o ${OBJECTDIR}/_ext/1360937237/profile.o ../src/profile.c 
+	
+${OBJECTDIR}/_ext/1360937237/sram.o: ../src/sram.c  .generated_files/flags/default/f13789d89db0a6a47c0771c9aefb615eef991c96 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/sram.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/sram.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/sram.o.d" -MT "${OBJECTDIR}/_ext/1360937237/sram.o.d" -MT ${OBJECTDIR}/_ext/1360937237/sram.o -o ${OBJECTDIR}/_ext/1360937237/sram.o ../src/sram.c 
+	
+${OBJECTDIR}/_ext/1360937237/move_detect.o: ../src/move_detect.c  .generated_files/flags/default/a20f9a9c530fe7fd5dc128306166067564b0b84a .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/move_detect.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/move_detect.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/move_detect.o.d" -MT "${OBJECTDIR}/_ext/1360937237/move_detect.o.d" -MT ${OBJECTDIR}/_ext/1360937237/move_detect.o -o ${OBJECTDIR}/_ext/1360937237/move_detect.o ../src/move_detect.c 
+	
+${OBJECTDIR}/_ext/1360937237/recorder.o: ../src/recorder.c  .generated_files/flags/default/d40d5d871823ca6d94ceecf9e26506b471069955 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/recorder.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/recorder.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/recorder.o.d" -MT "${OBJECTDIR}/_ext/1360937237/recorder.o.d" -MT ${OBJECTDIR}/_ext/1360937237/recorder.o -o ${OBJECTDIR}/_ext/1360937237/recorder.o ../src/recorder.c 
+	
+${OBJECTDIR}/_ext/1360937237/idle.o: ../src/idle.c  .generated_files/flags/default/92390c0d4562a11ab273bc60af3dbd5379fb2ed1 .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/idle.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/idle.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/1360937237/idle.o.d" -MT "${OBJECTDIR}/_ext/1360937237/idle.o.d" -MT ${OBJECTDIR}/_ext/1360937237/idle.o -o ${OBJECTDIR}/_ext/1360937237/idle.o ../src/idle.c 
+	
+${OBJECTDIR}/_ext/2117234910/chess_core.o: ../ESP32_lichess/src/chess_core/chess_core.c  .generated_files/flags/default/ad4f6ac75cad0b6e489d1cbbe79f98226378cadb .generated_files/flags/default/da39a3ee5e6b4b0d3255bfef95601890afd80709
+	@${MKDIR} "${OBJECTDIR}/_ext/2117234910" 
+	@${RM} ${OBJECTDIR}/_ext/2117234910/chess_core.o.d 
+	@${RM} ${OBJECTDIR}/_ext/2117234910/chess_core.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -c  -x c -D__$(MP_PROCESSOR_OPTION)__   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -gdwarf-3 -mno-const-data-in-progmem     -MD -MP -MF "${OBJECTDIR}/_ext/2117234910/chess_core.o.d" -MT "${OBJECTDIR}/_ext/2117234910/chess_core.o.d" -MT ${OBJECTDIR}/_ext/2117234910/chess_core.o -o ${OBJECTDIR}/_ext/2117234910/chess_core.o ../ESP32_lichess/src/chess_core/chess_core.c 
 	
 endif
 
@@ -168,14 +336,14 @@ endif
 ifeq ($(TYPE_IMAGE), DEBUG_RUN)
 ${DISTDIR}/chess.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}: ${OBJECTFILES}  nbproject/Makefile-${CND_CONF}.mk    
 	@${MKDIR} ${DISTDIR} 
-	${MP_CC} $(MP_EXTRA_LD_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -Wl,-Map=${DISTDIR}/chess.X.${IMAGE_TYPE}.map  -D__DEBUG=1  -DXPRJ_default=$(CND_CONF)  -Wl,--defsym=__MPLAB_BUILD=1   -mdfp="${DFP_DIR}/xc8"   -gdwarf-2 -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -Wall -gdwarf-3 -mno-const-data-in-progmem     $(COMPARISON_BUILD) -Wl,--memorysummary,${DISTDIR}/memoryfile.xml -o ${DISTDIR}/chess.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  -o ${DISTDIR}/chess.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}      -Wl,--start-group  -Wl,-lm -Wl,--end-group  -Wl,--defsym=__MPLAB_DEBUG=1,--defsym=__DEBUG=1
+	${MP_CC} $(MP_EXTRA_LD_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -Wl,-Map=${DISTDIR}/chess.X.${IMAGE_TYPE}.map  -D__DEBUG=1  -DXPRJ_default=$(CND_CONF)  -Wl,--defsym=__MPLAB_BUILD=1   -mdfp="${DFP_DIR}/xc8"   -gdwarf-2 -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -gdwarf-3 -mno-const-data-in-progmem     $(COMPARISON_BUILD) -Wl,--memorysummary,${DISTDIR}/memoryfile.xml -o ${DISTDIR}/chess.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  -o ${DISTDIR}/chess.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}      -Wl,--start-group  -Wl,-lm -Wl,--end-group  -Wl,--defsym=__MPLAB_DEBUG=1,--defsym=__DEBUG=1
 	@${RM} ${DISTDIR}/chess.X.${IMAGE_TYPE}.hex 
 	
 	
 else
 ${DISTDIR}/chess.X.${IMAGE_TYPE}.${OUTPUT_SUFFIX}: ${OBJECTFILES}  nbproject/Makefile-${CND_CONF}.mk   
 	@${MKDIR} ${DISTDIR} 
-	${MP_CC} $(MP_EXTRA_LD_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -Wl,-Map=${DISTDIR}/chess.X.${IMAGE_TYPE}.map  -DXPRJ_default=$(CND_CONF)  -Wl,--defsym=__MPLAB_BUILD=1   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -Wall -gdwarf-3 -mno-const-data-in-progmem     $(COMPARISON_BUILD) -Wl,--memorysummary,${DISTDIR}/memoryfile.xml -o ${DISTDIR}/chess.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  -o ${DISTDIR}/chess.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}      -Wl,--start-group  -Wl,-lm -Wl,--end-group 
+	${MP_CC} $(MP_EXTRA_LD_PRE) -mcpu=$(MP_PROCESSOR_OPTION) -Wl,-Map=${DISTDIR}/chess.X.${IMAGE_TYPE}.map  -DXPRJ_default=$(CND_CONF)  -Wl,--defsym=__MPLAB_BUILD=1   -mdfp="${DFP_DIR}/xc8"  -Wl,--gc-sections -O1 -ffunction-sections -fdata-sections -fshort-enums -fno-common -funsigned-char -funsigned-bitfields -I"../" -I"../avr-print" -I"../src" -I"../ESP32_lichess/src/chess_core" -Wall -gdwarf-3 -mno-const-data-in-progmem     $(COMPARISON_BUILD) -Wl,--memorysummary,${DISTDIR}/memoryfile.xml -o ${DISTDIR}/chess.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  -o ${DISTDIR}/chess.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}  ${OBJECTFILES_QUOTED_IF_SPACED}      -Wl,--start-group  -Wl,-lm -Wl,--end-group 
 	${MP_CC_DIR}\\avr-objcopy -O ihex "${DISTDIR}/chess.X.${IMAGE_TYPE}.${DEBUGGABLE_SUFFIX}" "${DISTDIR}/chess.X.${IMAGE_TYPE}.hex"
 	
 endif
@@ -0,0 +1,289 @@
+/*
+  Host tests for the shared chess core (ESP32_lichess/src/chess_core): FEN import and
+  export, castling rights and the castling rules, en passant, promotion, SAN parsing and
+  perft counts of the legal move generator against published values.
+
+  Build from the repo root:
+    gcc -O2 -std=c99 -IESP32_lichess/src/chess_core host/chess_core_test.c \
+        ESP32_lichess/src/chess_core/chess_core.c -o chess_core_test
+  Run:
+    ./chess_core_test
+  Prints each failed check and exits 1 if there was any.
+*/
+
+#include "chess_core.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define KIWIPETE "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"
+
+static unsigned checks, failures;
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+static void check(int ok, const char* what, int line) {
+    checks++;
+    if (ok) return;
+    failures++;
+    printf("line %d: failed: %s\n", line, what);
+}
+
+static void check_fen(const cc_position_t* pos, const char* want, int line) {
+    char fen[CC_FEN_MAX];
+    cc_to_fen(pos, fen, sizeof(fen));
+    checks++;
+    if (strcmp(fen, want) == 0) return;
+    failures++;
+    printf("line %d: FEN %s, expected %s\n", line, fen, want);
+}
+
+#define CHECK_FEN(pos, want) check_fen((pos), (want), __LINE__)
+
+static int legal(const cc_position_t* pos, const char* uci, cc_move_t* mv) {
+    return cc_parse_uci(pos, uci, mv) && cc_is_legal(pos, mv);
+}
+
+// Play a space-separated list of UCI or SAN moves; false at the first that isn't legal
+static int play(cc_position_t* pos, const char* moves) {
+    char tok[16];
+    while ((moves = cc_next_move_token(moves, tok, sizeof(tok))) != NULL) {
+        cc_move_t mv;
+        if (!cc_parse_move(pos, tok, &mv) || !cc_is_legal(pos, &mv)) {
+            printf("can't play %s\n", tok);
+            return 0;
+        }
+        cc_apply(pos, &mv);
+    }
+    return 1;
+}
+
+// Is uci among the generated legal moves?
+static int generated(const cc_position_t* pos, const char* uci) {
+    cc_move_t moves[256];
+    size_t n = cc_generate_moves(pos, moves, 256);
+    for (size_t i = 0; i < n && i < 256; i++) {
+        char s[6];
+        cc_move_to_uci(&moves[i], s);
+        if (strcmp(s, uci) == 0) return 1;
+    }
+    return 0;
+}
+
+static unsigned long perft(cc_position_t* pos, unsigned depth) {
+    cc_move_t moves[256];
+    size_t n = cc_generate_moves(pos, moves, 256);
+    if (depth == 1 || n > 256) return n;
+    unsigned long nodes = 0;
+    for (size_t i = 0; i < n; i++) {
+        cc_apply(pos, &moves[i]);
+        nodes += perft(pos, depth - 1);
+        cc_undo(pos, &moves[i]);
+    }
+    return nodes;
+}
+
+static void test_fen(void) {
+    static const char* const fens[] = {
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+        KIWIPETE,
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+        "r3k2r/8/8/8/8/8/8/R3K2R b Kq - 12 40",
+    };
+    cc_position_t pos, start;
+    for (size_t i = 0; i < sizeof(fens) / sizeof(fens[0]); i++) {
+        CHECK(cc_from_fen(&pos, fens[i]));
+        CHECK_FEN(&pos, fens[i]);
+    }
+    cc_position_start(&start);
+    CHECK(cc_from_fen(&pos, fens[0]));
+    CHECK(memcmp(&pos, &start, sizeof(pos)) == 0);
+    CHECK(cc_occupancy(&pos) == 0xC3C3C3C3C3C3C3C3ULL);
+    CHECK(cc_piece_at(&pos, cc_parse_square("e1")) == CC_PIECE(CC_WHITE, CC_KING));
+    CHECK(cc_piece_at(&pos, cc_parse_square("d8")) == CC_PIECE(CC_BLACK, CC_QUEEN));
+
+    CHECK(!cc_from_fen(&pos, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1"));
+    CHECK(!cc_from_fen(&pos, "rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+    CHECK(!cc_from_fen(&pos, "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNX w KQkq - 0 1"));
+}
+
+static void test_castling(void) {
+    cc_position_t pos;
+    cc_move_t mv;
+
+    // rook squares and the undo
+    cc_from_fen(&pos, "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    CHECK(legal(&pos, "e1g1", &mv));
+    CHECK((mv.flags & CC_MOVE_CASTLE) && mv.rook_from == cc_parse_square("h1") && mv.rook_to == cc_parse_square("f1"));
+    cc_apply(&pos, &mv);
+    CHECK_FEN(&pos, "r3k2r/8/8/8/8/8/8/R4RK1 b kq - 1 1");
+    cc_undo(&pos, &mv);
+    CHECK_FEN(&pos, "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    CHECK(legal(&pos, "e1c1", &mv));
+    CHECK(mv.rook_from == cc_parse_square("a1") && mv.rook_to == cc_parse_square("d1"));
+
+    // out of, through and into check
+    cc_from_fen(&pos, "4k3/8/8/8/8/8/4r3/R3K2R w KQ - 0 1");
+    CHECK(!legal(&pos, "e1g1", &mv));
+    CHECK(!generated(&pos, "e1g1") && !generated(&pos, "e1c1"));
+    cc_from_fen(&pos, "4k3/8/8/8/8/8/5r2/R3K2R w KQ - 0 1");
+    CHECK(!legal(&pos, "e1g1", &mv) && !generated(&pos, "e1g1"));
+    CHECK(legal(&pos, "e1c1", &mv) && generated(&pos, "e1c1"));
+    cc_from_fen(&pos, "4k3/8/8/8/8/8/6r1/R3K2R w KQ - 0 1");
+    CHECK(!generated(&pos, "e1g1"));
+    // b1 may be attacked on the long side, and a blocked path is no castle
+    cc_from_fen(&pos, "4k3/8/8/8/8/8/1r6/R3K2R w KQ - 0 1");
+    CHECK(generated(&pos, "e1c1"));
+    cc_from_fen(&pos, "4k3/8/8/8/8/8/8/RN2K2R w KQ - 0 1");
+    CHECK(!generated(&pos, "e1c1") && generated(&pos, "e1g1"));
+
+    // rights lost to king moves, rook moves and a rook captured on its square
+    cc_from_fen(&pos, "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    CHECK(play(&pos, "h1h2"));
+    CHECK(pos.castling == (CC_CASTLE_WQ | CC_CASTLE_BK | CC_CASTLE_BQ));
+    CHECK(play(&pos, "e8d8"));
+    CHECK(pos.castling == CC_CASTLE_WQ);
+    cc_from_fen(&pos, "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    CHECK(play(&pos, "a1a8"));
+    CHECK(pos.castling == (CC_CASTLE_WK | CC_CASTLE_BK));
+    CHECK(!legal(&pos, "e8c8", &mv));
+    // the right is kept, but not out of check
+    CHECK(!legal(&pos, "e8g8", &mv) && !generated(&pos, "e8g8"));
+    cc_from_fen(&pos, "r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1");
+    CHECK(play(&pos, "e1f1 a8a1"));
+    CHECK(pos.castling == CC_CASTLE_BK);
+    CHECK(!generated(&pos, "e1g1"));
+}
+
+static void test_en_passant(void) {
+    cc_position_t pos;
+    cc_move_t mv;
+    cc_position_start(&pos);
+    CHECK(play(&pos, "e2e4 a7a6 e4e5 d7d5"));
+    CHECK(pos.ep == cc_parse_square("d6"));
+    CHECK(legal(&pos, "e5d6", &mv));
+    CHECK((mv.flags & CC_MOVE_EN_PASSANT) && mv.capture_sq == cc_parse_square("d5") &&
+          mv.captured == CC_PIECE(CC_BLACK, CC_PAWN));
+    cc_apply(&pos, &mv);
+    CHECK_FEN(&pos, "rnbqkbnr/1pp1pppp/p2P4/8/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 3");
+    cc_undo(&pos, &mv);
+    CHECK_FEN(&pos, "rnbqkbnr/1pp1pppp/p7/3pP3/8/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 3");
+
+    // only right after the double push
+    CHECK(play(&pos, "h2h3 h7h6"));
+    CHECK(pos.ep == CC_NO_SQUARE);
+    CHECK(!legal(&pos, "e5d6", &mv) && !generated(&pos, "e5d6"));
+
+    // not when it exposes the king along the rank
+    cc_from_fen(&pos, "8/8/8/K2pP2r/8/8/8/7k w - d6 0 1");
+    CHECK(!generated(&pos, "e5d6"));
+    CHECK(generated(&pos, "e5e6"));
+}
+
+static void test_promotion(void) {
+    cc_position_t pos;
+    cc_move_t mv;
+    cc_from_fen(&pos, "1r2k3/P7/8/8/8/8/8/4K3 w - - 0 1");
+    CHECK(legal(&pos, "a7a8n", &mv));
+    CHECK((mv.flags & CC_MOVE_PROMOTION) && mv.promo == CC_PIECE(CC_WHITE, CC_KNIGHT));
+    cc_apply(&pos, &mv);
+    CHECK_FEN(&pos, "Nr2k3/8/8/8/8/8/8/4K3 b - - 0 1");
+    cc_undo(&pos, &mv);
+    CHECK(legal(&pos, "a7b8r", &mv));
+    CHECK(mv.promo == CC_PIECE(CC_WHITE, CC_ROOK) && mv.captured == CC_PIECE(CC_BLACK, CC_ROOK));
+    CHECK(cc_parse_uci(&pos, "a7b8b", &mv) && mv.promo == CC_PIECE(CC_WHITE, CC_BISHOP));
+    char uci[6];
+    cc_move_to_uci(&mv, uci);
+    CHECK(strcmp(uci, "a7b8b") == 0);
+    // an ATmega payload carries no promotion letter: a queen
+    CHECK(cc_parse_uci(&pos, "a7a8", &mv) && mv.promo == CC_PIECE(CC_WHITE, CC_QUEEN));
+    CHECK(!cc_parse_uci(&pos, "a7a8k", &mv));
+    // four moves per promotion square
+    CHECK(generated(&pos, "a7a8q") && generated(&pos, "a7a8r") && generated(&pos, "a7a8b") &&
+          generated(&pos, "a7a8n") && generated(&pos, "a7b8n"));
+}
+
+static void test_san(void) {
+    cc_position_t pos;
+    cc_move_t mv;
+    char uci[6];
+
+    // knights on b8 and f6 both reach d7: the file decides
+    cc_from_fen(&pos, "rn2kb1r/ppp1pppp/5n2/8/8/8/PPPPPPPP/RNBQKBNR b KQkq - 0 1");
+    CHECK(!cc_parse_san(&pos, "Nd7", &mv));
+    CHECK(cc_parse_san(&pos, "Nbd7", &mv) && mv.from == cc_parse_square("b8"));
+    CHECK(cc_parse_san(&pos, "Nfd7", &mv) && mv.from == cc_parse_square("f6"));
+    // rooks on one file: the rank decides
+    cc_from_fen(&pos, "4k3/R7/8/8/8/8/R7/4K3 w - - 0 1");
+    CHECK(!cc_parse_san(&pos, "Ra4", &mv));
+    CHECK(cc_parse_san(&pos, "R2a4", &mv) && mv.from == cc_parse_square("a2"));
+    CHECK(cc_parse_san(&pos, "R7a4", &mv) && mv.from == cc_parse_square("a7"));
+    // a pinned knight doesn't count as a second candidate
+    cc_from_fen(&pos, "4k3/8/8/b7/8/2N1N3/8/4K3 w - - 0 1");
+    CHECK(cc_parse_san(&pos, "Nd5", &mv) && mv.from == cc_parse_square("e3"));
+    cc_from_fen(&pos, "4k3/8/8/8/8/2N1N3/8/4K3 w - - 0 1");
+    CHECK(!cc_parse_san(&pos, "Nd5", &mv));
+    CHECK(cc_parse_san(&pos, "Ncd5", &mv) && mv.from == cc_parse_square("c3"));
+    CHECK(cc_parse_san(&pos, "Nc3d5", &mv) && mv.from == cc_parse_square("c3"));
+
+    // check and mate suffixes and annotations are ignored; a capture needs no 'x'
+    cc_position_start(&pos);
+    CHECK(play(&pos, "e4 e5 Bc4 Nc6 Qh5 Nf6"));
+    CHECK(cc_parse_san(&pos, "Qxf7#", &mv));
+    cc_move_to_uci(&mv, uci);
+    CHECK(strcmp(uci, "h5f7") == 0 && (mv.flags & CC_MOVE_CAPTURE));
+    CHECK(cc_parse_san(&pos, "Qf7+", &mv) && cc_parse_san(&pos, "Qxf7#!?", &mv));
+    CHECK(cc_parse_san(&pos, "Bxf7+", &mv) && mv.from == cc_parse_square("c4"));
+    // pawns by file, and what isn't a legal move here
+    CHECK(cc_parse_san(&pos, "d4", &mv) && mv.from == cc_parse_square("d2"));
+    CHECK(cc_parse_san(&pos, "d3", &mv) && mv.from == cc_parse_square("d2"));
+    CHECK(!cc_parse_san(&pos, "e5", &mv));
+    CHECK(!cc_parse_san(&pos, "Ke3", &mv));
+    CHECK(!cc_parse_san(&pos, "Nf6", &mv));
+    CHECK(!cc_parse_san(&pos, "Zz9", &mv));
+
+    // a PGN through the tokenizer
+    const char* pgn = "[Event \"test\"]\n1. e4 {best by test} e5 2.Nf3 (2. f4 exf4) Nc6 $1 3. Bb5 a6 1-0";
+    cc_position_start(&pos);
+    CHECK(play(&pos, pgn));
+    CHECK_FEN(&pos, "r1bqkbnr/1ppp1ppp/p1n5/1B2p3/4P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 0 4");
+}
+
+static void test_perft(void) {
+    static const struct {
+        const char* fen;
+        unsigned long nodes[3];
+    } cases[] = {
+        {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", {20, 400, 8902}},
+        {KIWIPETE, {48, 2039, 97862}},
+        {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", {14, 191, 2812}},
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        cc_position_t pos;
+        char before[CC_FEN_MAX];
+        cc_from_fen(&pos, cases[i].fen);
+        cc_to_fen(&pos, before, sizeof(before));
+        for (unsigned depth = 1; depth <= 3; depth++) {
+            unsigned long nodes = perft(&pos, depth);
+            checks++;
+            if (nodes != cases[i].nodes[depth - 1]) {
+                failures++;
+                printf("perft %u of %s: %lu, expected %lu\n", depth, cases[i].fen, nodes, cases[i].nodes[depth - 1]);
+            }
+        }
+        // apply / undo put everything back
+        CHECK_FEN(&pos, before);
+    }
+}
+
+int main(void) {
+    test_fen();
+    test_castling();
+    test_en_passant();
+    test_promotion();
+    test_san();
+    test_perft();
+    printf("%u checks, %u failed\n", checks, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""Flash and SRAM use per module, from the linker map of the ATmega build.
+
+Run by chess.X/Makefile after every build, with the python3 or python found on PATH
+(or MEM_BUDGET_PY=...; the check is skipped with a message when there is none):
+
+    python3 ../host/mem_budget.py dist/default [--flash N] [--ram N] [--module main.o:ram=700]
+
+The argument is a .map file, or a directory searched for the newest one. Sizes come
+from the input sections the linker kept (the build uses --gc-sections), per object file
+or library member:
+
+    flash  .text, .progmem and the .data init image
+    data   .data, which with -mno-const-data-in-progmem includes every string literal
+           not put in flash with PSTR()
+    bss    .bss and .noinit
+
+The run fails (exit 1) when flash or static SRAM (data + bss) goes over its budget, or a
+module over one given with --module. The static SRAM budget leaves room for the stack:
+src/sram.c reports how deep it actually goes.
+"""
+import argparse
+import os
+import re
+import sys
+from collections import defaultdict
+
+FLASH_SIZE = 32768
+SRAM_SIZE = 2048
+FLASH_BUDGET = FLASH_SIZE - 2048    # keep 2 KB spare
+RAM_BUDGET = SRAM_SIZE - 512        # the rest is the stack's
+
+# output section -> which totals its input sections count toward
+OUTPUT_KINDS = {
+    ".text": ("flash",),
+    ".data": ("flash", "data"),
+    ".bss": ("bss",),
+    ".noinit": ("bss",),
+}
+
+INPUT_RE = re.compile(r"^ (\S+)?\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+
+
+def find_map(path):
+    if os.path.isfile(path):
+        return path
+    maps = []
+    for root, _, files in os.walk(path):
+        maps += [os.path.join(root, f) for f in files if f.endswith(".map")]
+    if not maps:
+        return None
+    return max(maps, key=os.path.getmtime)
+
+
+def module_name(obj):
+    # "lib/libc.a(vfprintf_std.o)" -> "libc.a(vfprintf_std.o)", ".../_ext/123/main.o" -> "main.o"
+    obj = obj.strip().replace("\\", "/")
+    m = re.match(r"(.*?)([^/]+\.a)\((.+)\)$", obj)
+    if m:
+        return "%s(%s)" % (m.group(2), m.group(3))
+    return obj.rsplit("/", 1)[-1]
+
+
+def parse_map(path):
+    sizes = defaultdict(lambda: {"flash": 0, "data": 0, "bss": 0})
+    kinds = None
+    pending = None          # input section name on a line of its own, numbers on the next
+    in_memory_map = False
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if line.startswith("Linker script and memory map"):
+                in_memory_map = True
+                continue
+            if not in_memory_map:
+                continue
+            if line and not line[0].isspace():
+                out = line.split()[0]
+                kinds = OUTPUT_KINDS.get(out)
+                pending = None
+                continue
+            if kinds is None:
+                continue
+            m = INPUT_RE.match(line)
+            if m and (m.group(1) or pending):
+                name = m.group(1) or pending
+                pending = None
+                if name.startswith("*") or name == "*fill*":
+                    continue
+                size = int(m.group(3), 16)
+                if size:
+                    for kind in kinds:
+                        sizes[module_name(m.group(4))][kind] += size
+                continue
+            parts = line.split()
+            pending = parts[0] if len(parts) == 1 and parts[0].startswith(".") else None
+    return sizes
+
+
+def parse_module_budget(text):
+    # "main.o:ram=700,flash=6000"
+    name, _, rest = text.partition(":")
+    budget = {}
+    for item in rest.split(","):
+        key, _, value = item.partition("=")
+        if key not in ("flash", "ram") or not value:
+            raise argparse.ArgumentTypeError("bad module budget: %s" % text)
+        budget[key] = int(value, 0)
+    return name, budget
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("map", help=".map file, or a directory to take the newest .map from")
+    ap.add_argument("--flash", type=int, default=FLASH_BUDGET, help="flash budget, bytes")
+    ap.add_argument("--ram", type=int, default=RAM_BUDGET, help="static SRAM (data + bss) budget, bytes")
+    ap.add_argument("--module", type=parse_module_budget, action="append", default=[],
+                    metavar="NAME:ram=N,flash=N", help="budget for one module")
+    args = ap.parse_args()
+
+    path = find_map(args.map)
+    if path is None:
+        print("mem_budget: no .map under %s" % args.map, file=sys.stderr)
+        return 1
+    sizes = parse_map(path)
+    if not sizes:
+        print("mem_budget: no sections found in %s" % path, file=sys.stderr)
+        return 1
+
+    print("%-32s %7s %6s %6s %6s" % ("module (%s)" % os.path.basename(path), "flash", "data", "bss", "sram"))
+    rows = sorted(sizes.items(), key=lambda kv: (kv[1]["data"] + kv[1]["bss"], kv[1]["flash"]), reverse=True)
+    for name, s in rows:
+        print("%-32s %7d %6d %6d %6d" % (name, s["flash"], s["data"], s["bss"], s["data"] + s["bss"]))
+    flash = sum(s["flash"] for s in sizes.values())
+    data = sum(s["data"] for s in sizes.values())
+    bss = sum(s["bss"] for s in sizes.values())
+    print("%-32s %7d %6d %6d %6d" % ("total", flash, data, bss, data + bss))
+    print("flash %d of %d budget (%d device), static SRAM %d of %d budget (%d device, %d left for the stack)"
+          % (flash, args.flash, FLASH_SIZE, data + bss, args.ram, SRAM_SIZE, SRAM_SIZE - data - bss))
+
+    over = []
+    if flash > args.flash:
+        over.append("flash %d > %d" % (flash, args.flash))
+    if data + bss > args.ram:
+        over.append("static SRAM %d > %d" % (data + bss, args.ram))
+    for name, budget in args.module:
+        s = sizes.get(name, {"flash": 0, "data": 0, "bss": 0})
+        if "flash" in budget and s["flash"] > budget["flash"]:
+            over.append("%s flash %d > %d" % (name, s["flash"], budget["flash"]))
+        if "ram" in budget and s["data"] + s["bss"] > budget["ram"]:
+            over.append("%s SRAM %d > %d" % (name, s["data"] + s["bss"], budget["ram"]))
+    for o in over:
+        print("mem_budget: over budget: %s" % o, file=sys.stderr)
+    return 1 if over else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,116 @@
+/*
+  Host simulation of speculative gantry pre-positioning (src/gantry_plan.c).
+
+  Replays recorded games with the shared chess core. Every move is treated as one the gantry
+  has to make for the remote player; the head starts from home (init_pos() after each
+  command) or from plan_prepos_target() computed when that side started thinking. Travel to
+  the source square is timed with the gantry's x/y seconds per square; the fixed settle
+  delays between legs are left out. Assumes the opponent thinks long enough for the head to
+  arrive, which the printed pre-positioning travel can be checked against.
+
+  Build from the repo root:
+    gcc -O2 -std=c99 -Isrc -IESP32_lichess/src/chess_core host/prepos_sim.c src/gantry_plan.c \
+        ESP32_lichess/src/chess_core/chess_core.c -lm -o prepos_sim
+  Run:
+    ./prepos_sim [ESP32_lichess/host/games.txt]
+*/
+
+#include "gantry_plan.h"
+
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    unsigned moves;
+    double home_s;       // home -> source
+    double prepos_s;     // pre-positioning point -> source
+    double centroid_s;   // centroid of all the side's pieces instead, for comparison
+    double reach_s;      // home -> pre-positioning point, done while the opponent thinks
+} sim_totals_t;
+
+static void centroid(const cc_position_t* pos, uint8_t side, float* x, float* y) {
+    float sx = 0, sy = 0;
+    unsigned n = 0;
+    for (uint8_t sq = 0; sq < 64; sq++) {
+        if (!(pos->color[side] & CC_BB(sq))) continue;
+        sx += HEAD_X(sq);
+        sy += HEAD_Y(sq);
+        n++;
+    }
+    *x = n ? sx / n : 0;
+    *y = n ? sy / n : 0;
+}
+
+static int replay(const char* moves, sim_totals_t* t) {
+    cc_position_t pos;
+    cc_move_t mv;
+    char uci[6];
+    cc_position_start(&pos);
+    while (*moves) {
+        size_t n = strcspn(moves, " \r\n");
+        if (n >= 4 && n <= 5) {
+            memcpy(uci, moves, n);
+            uci[n] = '\0';
+            float px, py, cx, cy;
+            plan_prepos_target(&pos, pos.side, &px, &py);
+            centroid(&pos, pos.side, &cx, &cy);
+            if (!cc_apply_uci(&pos, uci, &mv)) {
+                fprintf(stderr, "bad move %s\n", uci);
+                return -1;
+            }
+            float sx = HEAD_X(mv.from), sy = HEAD_Y(mv.from);
+            t->moves++;
+            t->home_s += plan_travel_s(0, 0, sx, sy);
+            t->prepos_s += plan_travel_s(px, py, sx, sy);
+            t->centroid_s += plan_travel_s(cx, cy, sx, sy);
+            t->reach_s += plan_travel_s(0, 0, px, py);
+        }
+        moves += n;
+        moves += strspn(moves, " \r\n");
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "ESP32_lichess/host/games.txt";
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    char line[4096];
+    sim_totals_t total = {0};
+    unsigned games = 0, faster = 0;
+    double best = 0, worst = 0;     // per-game change in travel, percent
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        sim_totals_t g = {0};
+        if (replay(line, &g) < 0) continue;
+        double change = 100.0 * (g.prepos_s / g.home_s - 1.0);
+        if (!games || change < best) best = change;
+        if (!games || change > worst) worst = change;
+        if (change < 0) faster++;
+        games++;
+        printf("game %u: %u moves  to source: home %.1f s  pre-positioned %.1f s (%+.0f%%)\n",
+               games, g.moves, g.home_s, g.prepos_s, change);
+        total.moves += g.moves;
+        total.home_s += g.home_s;
+        total.prepos_s += g.prepos_s;
+        total.centroid_s += g.centroid_s;
+        total.reach_s += g.reach_s;
+    }
+    fclose(f);
+    if (!total.moves) {
+        printf("no games in %s\n", path);
+        return 1;
+    }
+    printf("\n%u games, %u moves, mean travel to the source square:\n", games, total.moves);
+    printf("  from home               %.2f s\n", total.home_s / total.moves);
+    printf("  from median (used)      %.2f s  (%.0f%% less)\n", total.prepos_s / total.moves,
+           100.0 * (1.0 - total.prepos_s / total.home_s));
+    printf("  from all-piece centroid %.2f s  (%.0f%% less)\n", total.centroid_s / total.moves,
+           100.0 * (1.0 - total.centroid_s / total.home_s));
+    printf("  pre-positioning trip    %.2f s (while the opponent thinks)\n", total.reach_s / total.moves);
+    printf("per game: %u of %u faster, best %+.0f%%, worst %+.0f%%\n", faster, games, best, worst);
+    return 0;
+}
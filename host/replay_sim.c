@@ -0,0 +1,197 @@
+/*
+  Host simulation of the hardware game replay ("replay" on the ESP's Serial Monitor).
+
+  Takes the same input: a PGN or a space-separated UCI move list, one game per file. Each
+  move is turned into the ATmega payload the ESP would send and split into gantry moves the
+  way process_chess_command() does (a captured piece goes to its file's graveyard slot
+  first, a castle moves king then rook). Every gantry move is timed leg by leg as
+  move_piece() drives it: travel to the source, pick-up, the half-square offsets onto the
+  square edges, the carry, release, each leg at the nominal seconds per square and followed
+  by GANTRY_SETTLE_MS. The head re-homes after every move, or every PLACE_REHOME_EVERY
+  moves with a calibration (-c), as place_piece() does. Placement retries aren't modelled,
+  so a board slower than this shows what its retries and homing cost.
+
+  The per-move lines and the summary are laid out like the ESP's replay report so the two
+  can be put side by side.
+
+  Build from the repo root:
+    gcc -O2 -std=c99 -Isrc -IESP32_lichess/src/chess_core host/replay_sim.c src/gantry_plan.c \
+        ESP32_lichess/src/chess_core/chess_core.c -lm -o replay_sim
+  Run:
+    ./replay_sim [-c] [game.pgn ...]       (stdin if no file)
+*/
+
+#include "gantry_plan.h"
+#include "magnet.h"
+#include "placement.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Homing as in src/steppermotor.c: fast back to the switches, back off, slow approach, then
+// out to the centre of a8
+#define HOME_BACKOFF_SQUARES 0.25f
+#define HOME_SLOW_S_PER_SQUARE (180.0f / 40.0f)     // HOME_SLOW_HZ
+#define HOME_Y_OFFSET -0.811f
+
+typedef struct {
+    float x, y;                 // head, squares from home
+    unsigned since_home;
+    int calibrated;
+} gantry_t;
+
+typedef struct {
+    unsigned moves, gantry_moves, homings;
+    double total_s, max_s;
+} sim_totals_t;
+
+static double leg_s(float squares, float s_per_square) {
+    return fabsf(squares) * s_per_square + GANTRY_SETTLE_MS / 1000.0;
+}
+
+static double homing_s(gantry_t* g) {
+    double s = g->x * GANTRY_S_PER_SQUARE_X + (g->y - HOME_Y_OFFSET) * GANTRY_S_PER_SQUARE_Y;
+    s += HOME_BACKOFF_SQUARES * (GANTRY_S_PER_SQUARE_X + GANTRY_S_PER_SQUARE_Y);
+    s += HOME_BACKOFF_SQUARES * 2 * HOME_SLOW_S_PER_SQUARE;
+    s += -HOME_Y_OFFSET * GANTRY_S_PER_SQUARE_Y;
+    g->x = g->y = 0;
+    return s;
+}
+
+// move_piece() leg by leg; sq 64..71 are graveyard slots (y = -1)
+static double piece_move_s(gantry_t* g, uint8_t from, uint8_t to) {
+    float sx, sy, ex, ey;
+    plan_head_xy(from, &sx, &sy);
+    plan_head_xy(to, &ex, &ey);
+    double s = 0;
+    if (fabsf(sx - g->x) > 0.05f) s += leg_s(sx - g->x, GANTRY_S_PER_SQUARE_X);
+    if (fabsf(sy - g->y) > 0.05f) s += leg_s(sy - g->y, GANTRY_S_PER_SQUARE_Y);
+    s += MAGNET_PULLIN_MS / 1000.0;
+
+    int off_x = sy != ey, off_y = sx != ex;
+    float cur_x = 0, cur_y = 0, tgt_x = 0, tgt_y = 0;
+    if (off_x) {
+        cur_x = sx == 0 ? 0.5f : -0.5f;
+        tgt_x = ex == 0 ? 0.5f : -0.5f;
+        s += leg_s(0.5f, GANTRY_S_PER_SQUARE_X);
+    }
+    if (off_y) {
+        cur_y = 0.5f;
+        tgt_y = -0.5f;
+        s += leg_s(0.5f, GANTRY_S_PER_SQUARE_Y);
+    }
+    float mx = (ex + tgt_x) - (sx + cur_x);
+    float my = (ey + tgt_y) - (sy + cur_y);
+    if (mx != 0) s += leg_s(mx, GANTRY_S_PER_SQUARE_X);
+    if (my != 0) s += leg_s(my, GANTRY_S_PER_SQUARE_Y);
+    if (off_y) s += leg_s(0.5f, GANTRY_S_PER_SQUARE_Y);
+    if (off_x) s += leg_s(0.5f, GANTRY_S_PER_SQUARE_X);
+    s += MAGNET_RELEASE_MS / 1000.0;
+    g->x = ex;
+    g->y = ey;
+    return s;
+}
+
+// place_piece() without retries
+static double place_s(gantry_t* g, uint8_t from, uint8_t to, sim_totals_t* t) {
+    double s = piece_move_s(g, from, to);
+    t->gantry_moves++;
+    if (!g->calibrated || ++g->since_home >= PLACE_REHOME_EVERY) {
+        s += homing_s(g);
+        g->since_home = 0;
+        t->homings++;
+    }
+    return s;
+}
+
+// process_chess_command() for the payload the ESP builds from mv
+static double command_s(gantry_t* g, const cc_move_t* mv, char payload[9], sim_totals_t* t) {
+    double s = 0;
+    cc_square_name(mv->from, payload);
+    cc_square_name(mv->to, payload + 2);
+    if (mv->flags & CC_MOVE_CASTLE) {
+        cc_square_name(mv->rook_from, payload + 4);
+        cc_square_name(mv->rook_to, payload + 6);
+        s += place_s(g, mv->from, mv->to, t);
+        s += place_s(g, mv->rook_from, mv->rook_to, t);
+    } else if (mv->flags & CC_MOVE_CAPTURE) {
+        cc_square_name(mv->capture_sq, payload + 4);
+        s += place_s(g, mv->capture_sq, PLAN_GRAVEYARD(CC_FILE(mv->capture_sq)), t);
+        s += place_s(g, mv->from, mv->to, t);
+    } else {
+        s += place_s(g, mv->from, mv->to, t);
+    }
+    return s;
+}
+
+static char* read_all(FILE* f) {
+    size_t cap = 4096, len = 0;
+    char* buf = malloc(cap);
+    size_t n;
+    while (buf && (n = fread(buf + len, 1, cap - len - 1, f)) > 0) {
+        len += n;
+        if (len + 1 == cap) buf = realloc(buf, cap *= 2);
+    }
+    if (buf) buf[len] = '\0';
+    return buf;
+}
+
+static int simulate(const char* text, int calibrated) {
+    gantry_t g = {0, 0, 0, calibrated};
+    sim_totals_t t = {0};
+    cc_position_t pos;
+    cc_position_start(&pos);
+    char tok[16];
+    while ((text = cc_next_move_token(text, tok, sizeof(tok))) != NULL) {
+        cc_move_t mv;
+        char payload[9] = "";
+        if (!cc_parse_move(&pos, tok, &mv)) {
+            printf("move %u: can't play %s, stopping\n", t.moves + 1, tok);
+            break;
+        }
+        cc_apply(&pos, &mv);
+        double s = command_s(&g, &mv, payload, &t);
+        t.moves++;
+        t.total_s += s;
+        if (s > t.max_s) t.max_s = s;
+        printf("move %u: %s %.0f ms\n", t.moves, payload, s * 1000);
+    }
+    if (!t.moves) {
+        printf("no moves\n");
+        return 1;
+    }
+    printf("replay: %u moves (%u gantry moves, %u homings), board time %.1f s, mean %.0f ms, max %.0f ms, "
+           "%.2f moves/min\n",
+           t.moves, t.gantry_moves, t.homings, t.total_s, t.total_s * 1000 / t.moves, t.max_s * 1000,
+           t.moves * 60.0 / t.total_s);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    int calibrated = 0, files = 0, err = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-c") == 0) {
+            calibrated = 1;
+            continue;
+        }
+        FILE* f = fopen(argv[i], "r");
+        if (!f) {
+            perror(argv[i]);
+            return 2;
+        }
+        char* text = read_all(f);
+        fclose(f);
+        printf("%s\n", argv[i]);
+        err |= text ? simulate(text, calibrated) : 1;
+        free(text);
+        files++;
+    }
+    if (!files) {
+        char* text = read_all(stdin);
+        err |= text ? simulate(text, calibrated) : 1;
+        free(text);
+    }
+    return err;
+}
@@ -0,0 +1,145 @@
+/*
+  Host benchmark for the board reset planner (plan_reset() in src/gantry_plan.c).
+
+  End positions come from the games in the move file and from random pseudo-legal playouts.
+  Captured pieces go to the graveyard slot of their file like process_chess_command() puts
+  them; a capture onto an already full slot is lost, as if removed by hand. Each position is
+  planned square by square (a1, a2, ... h8) and with nearest neighbour + 2-opt, and the
+  gantry time (empty travel + carrying, no settle delays) is compared.
+
+  Build from the repo root:
+    gcc -O2 -std=c99 -Isrc -IESP32_lichess/src/chess_core host/reset_bench.c src/gantry_plan.c \
+        ESP32_lichess/src/chess_core/chess_core.c -lm -o reset_bench
+  Run:
+    ./reset_bench [ESP32_lichess/host/games.txt] [random positions]
+*/
+
+#define _POSIX_C_SOURCE 199309L
+#include "gantry_plan.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    unsigned positions, failed, moves_naive, moves_opt, max_moves;
+    double naive_s, opt_s, plan_us;
+} bench_t;
+
+static void capture_to_graveyard(const cc_move_t* mv, uint8_t graveyard[8]) {
+    if (!mv->captured) return;
+    uint8_t f = CC_FILE(mv->capture_sq);
+    if (!graveyard[f]) graveyard[f] = mv->captured;
+}
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void bench_position(const cc_position_t* pos, const uint8_t graveyard[8], bench_t* b, int verbose) {
+    reset_plan_t naive, opt;
+    double t0 = now_us();
+    bool ok = plan_reset(pos, graveyard, true, &opt);
+    b->plan_us += now_us() - t0;
+    if (!ok || !plan_reset(pos, graveyard, false, &naive)) {
+        b->failed++;
+        return;
+    }
+    b->positions++;
+    b->naive_s += plan_reset_cost_s(&naive);
+    b->opt_s += plan_reset_cost_s(&opt);
+    b->moves_naive += naive.count;
+    b->moves_opt += opt.count;
+    if (opt.count > b->max_moves) b->max_moves = opt.count;
+    if (verbose) {
+        printf("  %u moves, %u missing, %u extra: naive %.0f s, optimised %.0f s\n  ",
+               opt.count, opt.missing, opt.extras, plan_reset_cost_s(&naive), plan_reset_cost_s(&opt));
+        for (uint8_t i = 0; i < opt.count; i++) {
+            char a[3], c[3];
+            plan_square_name(opt.moves[i].from, a);
+            plan_square_name(opt.moves[i].to, c);
+            printf("%s%s ", a, c);
+        }
+        printf("\n");
+    }
+}
+
+// Random pseudo-legal move for the side to move, 0 if it has none
+static int random_move(cc_position_t* pos, cc_move_t* out) {
+    cc_move_t moves[256];
+    int n = 0;
+    char uci[5];
+    for (uint8_t from = 0; from < 64; from++) {
+        uint8_t p = cc_piece_at(pos, from);
+        if (!p || CC_COLOR(p) != pos->side) continue;
+        cc_square_name(from, uci);
+        for (uint8_t to = 0; to < 64 && n < 256; to++) {
+            cc_square_name(to, uci + 2);
+            if (cc_parse_uci(pos, uci, &moves[n]) && cc_is_pseudo_legal(pos, &moves[n])) n++;
+        }
+    }
+    if (!n) return 0;
+    *out = moves[rand() % n];
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "ESP32_lichess/host/games.txt";
+    int random_positions = argc > 2 ? atoi(argv[2]) : 500;
+    bench_t games = {0}, random = {0};
+
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    char line[4096];
+    printf("final positions of %s:\n", path);
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        cc_position_t pos;
+        cc_move_t mv;
+        uint8_t graveyard[8] = {0};
+        cc_position_start(&pos);
+        for (char* tok = strtok(line, " \r\n"); tok; tok = strtok(NULL, " \r\n")) {
+            if (!cc_apply_uci(&pos, tok, &mv)) break;
+            capture_to_graveyard(&mv, graveyard);
+        }
+        bench_position(&pos, graveyard, &games, 1);
+    }
+    fclose(f);
+
+    srand(1);
+    for (int i = 0; i < random_positions; i++) {
+        cc_position_t pos;
+        cc_move_t mv;
+        uint8_t graveyard[8] = {0};
+        cc_position_start(&pos);
+        int plies = 20 + rand() % 80;
+        for (int p = 0; p < plies && random_move(&pos, &mv); p++) {
+            // never take a king: the reset needs both
+            if (CC_TYPE(mv.captured) == CC_KING) continue;
+            cc_apply(&pos, &mv);
+            capture_to_graveyard(&mv, graveyard);
+        }
+        bench_position(&pos, graveyard, &random, 0);
+    }
+
+    const bench_t* sets[2] = { &games, &random };
+    const char* names[2] = { "games", "random playouts" };
+    for (int i = 0; i < 2; i++) {
+        const bench_t* b = sets[i];
+        if (!b->positions) continue;
+        printf("\n%s: %u positions (%u unplannable)\n", names[i], b->positions, b->failed);
+        printf("  square by square     %7.1f s  %5.1f moves\n", b->naive_s / b->positions,
+               (double)b->moves_naive / b->positions);
+        printf("  nearest + 2-opt      %7.1f s  %5.1f moves  (%.0f%% less, max %u moves)\n",
+               b->opt_s / b->positions, (double)b->moves_opt / b->positions,
+               100.0 * (1.0 - b->opt_s / b->naive_s), b->max_moves);
+        printf("  planning time (host) %7.0f us per position\n", b->plan_us / (b->positions + b->failed));
+    }
+    return 0;
+}
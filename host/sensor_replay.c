@@ -0,0 +1,276 @@
+/*
+  Host replay of sensor recordings (src/recorder.c) through the move detection
+  (src/move_detect.c), compiled natively.
+
+  Send "rec" on the ESP's Serial Monitor and save the log: the ATmega's "rc:" lines are
+  the recording. The replay starts from the recorded detector state (or idle on the raw
+  columns, if the ring had wrapped), applies the events in order and runs the detector
+  once per recorded scan. Its results are compared with the ones the firmware recorded,
+  so a change to the detector can be checked against real traces. For every move it also
+  prints the detection latency: from the scan where the target square's switch closed to
+  the scan that completed the move.
+
+  Build from the repo root:
+    gcc -O2 -std=c99 -Isrc -IESP32_lichess/src/chess_core host/sensor_replay.c src/move_detect.c \
+        ESP32_lichess/src/chess_core/chess_core.c -o sensor_replay
+  Run:
+    ./sensor_replay [log.txt ...]       (stdin if no file)
+  Exits 1 if any replayed result differs from the recorded one.
+*/
+
+#include "move_detect.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_RESULTS 256
+
+typedef struct {
+    unsigned long ms;
+    detect_result_t result;
+    uint8_t from, to, captured;     // CC_NO_SQUARE where the result has none
+} outcome_t;
+
+typedef struct {
+    outcome_t recorded[MAX_RESULTS], replayed[MAX_RESULTS];
+    unsigned n_recorded, n_replayed;
+    unsigned scans, ambiguous;
+    unsigned long latency_sum, latency_max;
+    unsigned latency_n;
+} replay_t;
+
+static const char* const result_names[] = {
+    "none", "lifted", "added", "rook", "move", "returned", "second-lift", "ambiguous", "capture",
+};
+
+typedef struct {
+    move_detector_t d;
+    uint8_t raw[8], mask[8], failed;
+    cc_move_t last_move;
+    unsigned long rise_ms[64];      // when each square's raw switch last closed
+    int scan_pending;
+    unsigned long scan_ms;
+} sim_t;
+
+static int parse_hex8(const char* s, uint8_t out[8]) {
+    for (int i = 0; i < 8; i++) {
+        unsigned v;
+        if (sscanf(s + 2 * i, "%2x", &v) != 1) return 0;
+        out[i] = (uint8_t)v;
+    }
+    return 1;
+}
+
+static void outcome_of(const move_detector_t* d, detect_result_t r, unsigned long ms, outcome_t* o) {
+    o->ms = ms;
+    o->result = r;
+    o->from = o->to = o->captured = CC_NO_SQUARE;
+    if (r == DETECT_MOVE || r == DETECT_CAPTURE) {
+        o->from = CC_SQUARE(d->start_col, d->start_row);
+        o->to = CC_SQUARE(d->end_col, d->end_row);
+    }
+    if (r == DETECT_CAPTURE) o->captured = CC_SQUARE(d->captured_col, d->captured_row);
+}
+
+static void run_scan(sim_t* sim, replay_t* rp) {
+    if (!sim->scan_pending) return;
+    sim->scan_pending = 0;
+    rp->scans++;
+    detect_result_t r = move_detect_scan(&sim->d, sim->raw, sim->failed, sim->mask, &sim->last_move);
+    sim->failed = 0;
+    if (r == DETECT_NONE) return;
+    if (r == DETECT_AMBIGUOUS) rp->ambiguous++;
+    // what main.c does with g_last_move; a castle's 'K' event follows its move
+    if (r == DETECT_ROOK || r == DETECT_MOVE || r == DETECT_CAPTURE) sim->last_move.flags = 0;
+    if (rp->n_replayed == MAX_RESULTS) return;
+    outcome_t* o = &rp->replayed[rp->n_replayed++];
+    outcome_of(&sim->d, r, sim->scan_ms, o);
+    if (o->to != CC_NO_SQUARE) {
+        unsigned long lat = sim->scan_ms - sim->rise_ms[o->to];
+        rp->latency_sum += lat;
+        rp->latency_n++;
+        if (lat > rp->latency_max) rp->latency_max = lat;
+    }
+}
+
+static void print_outcome(const char* who, const outcome_t* o) {
+    char from[3], to[3], cap[3];
+    cc_square_name(o->from, from);
+    cc_square_name(o->to, to);
+    cc_square_name(o->captured, cap);
+    printf("  %-8s %8lu ms  %-11s", who, o->ms, result_names[o->result]);
+    if (o->from != CC_NO_SQUARE) printf(" %s%s", from, to);
+    if (o->captured != CC_NO_SQUARE) printf(" x%s", cap);
+    printf("\n");
+}
+
+// Compare in order; returns the number of differences
+static unsigned compare(const replay_t* rp) {
+    unsigned diffs = 0;
+    unsigned n = rp->n_recorded > rp->n_replayed ? rp->n_recorded : rp->n_replayed;
+    for (unsigned i = 0; i < n; i++) {
+        const outcome_t* a = i < rp->n_recorded ? &rp->recorded[i] : NULL;
+        const outcome_t* b = i < rp->n_replayed ? &rp->replayed[i] : NULL;
+        if (a && b && a->result == b->result && a->from == b->from && a->to == b->to && a->captured == b->captured) {
+            continue;
+        }
+        printf("result %u differs:\n", i + 1);
+        if (a) print_outcome("firmware", a);
+        else printf("  firmware (none)\n");
+        if (b) print_outcome("replay", b);
+        else printf("  replay   (none)\n");
+        diffs++;
+    }
+    return diffs;
+}
+
+static unsigned finish(const replay_t* rp, unsigned events, int exact) {
+    unsigned moves = 0;
+    for (unsigned i = 0; i < rp->n_replayed; i++) {
+        const outcome_t* o = &rp->replayed[i];
+        if (o->result == DETECT_MOVE || o->result == DETECT_CAPTURE) {
+            print_outcome("move", o);
+            moves++;
+        }
+    }
+    unsigned diffs = compare(rp);
+    printf("recording: %u events, %u scans, start %s\n", events, rp->scans,
+           exact ? "exact" : "idle on the raw columns (ring had wrapped)");
+    printf("detector:  %u results (firmware %u), %u moves, %u ambiguous resets, %u differences\n",
+           rp->n_replayed, rp->n_recorded, moves, rp->ambiguous, diffs);
+    if (rp->latency_n) {
+        printf("latency:   switch closed -> move detected, mean %lu ms, max %lu ms\n",
+               rp->latency_sum / rp->latency_n, rp->latency_max);
+    }
+    return diffs;
+}
+
+// Replay one recording from "rc:begin" to "rc:end"; returns its number of differences
+static unsigned replay(FILE* f) {
+    static sim_t sim;
+    static replay_t rp;
+    char line[256];
+    unsigned events = 0;
+    int exact = 0, have_snap = 0;
+    memset(&sim, 0, sizeof(sim));
+    memset(&rp, 0, sizeof(rp));
+
+    while (fgets(line, sizeof(line), f)) {
+        char* rc = strstr(line, "rc:");
+        if (!rc) continue;
+        rc += 3;
+        if (strncmp(rc, "end", 3) == 0) break;
+        if (strncmp(rc, "begin", 5) == 0) {
+            unsigned n, e;
+            if (sscanf(rc + 5, "%u %u", &n, &e) == 2) exact = (int)e;
+            continue;
+        }
+        if (strncmp(rc, "snap", 4) == 0) {
+            int v[7];
+            char base[17], cur[17], raw[17], mask[17];
+            if (sscanf(rc + 4, "%d %d %d %d %d %d %d %16s %16s %16s %16s", &v[0], &v[1], &v[2], &v[3], &v[4],
+                       &v[5], &v[6], base, cur, raw, mask) != 11 ||
+                !parse_hex8(raw, sim.raw) || !parse_hex8(mask, sim.mask)) {
+                fprintf(stderr, "bad snap line: %s", line);
+                return 1;
+            }
+            if (exact) {
+                sim.d.state = (GameState_t)v[0];
+                sim.d.start_row = (int8_t)v[1];
+                sim.d.start_col = (int8_t)v[2];
+                sim.d.end_row = (int8_t)v[3];
+                sim.d.end_col = (int8_t)v[4];
+                sim.d.captured_row = (int8_t)v[5];
+                sim.d.captured_col = (int8_t)v[6];
+                parse_hex8(base, sim.d.base);
+                parse_hex8(cur, sim.d.current);
+            } else {
+                move_detect_reset(&sim.d, sim.raw);
+            }
+            have_snap = 1;
+            continue;
+        }
+
+        unsigned long ms;
+        char kind;
+        unsigned a, b;
+        if (!have_snap || sscanf(rc, "%lu %c %u %u", &ms, &kind, &a, &b) != 4) continue;
+        events++;
+        int scan_event = kind == 'C' || kind == 'F' || kind == 'M';
+        // a scan's events share its timestamp and come before anything it caused
+        if (sim.scan_pending && (!scan_event || ms != sim.scan_ms)) run_scan(&sim, &rp);
+        if (scan_event) {
+            sim.scan_pending = 1;
+            sim.scan_ms = ms;
+        }
+        switch (kind) {
+            case 'C':
+                for (unsigned r = 0; r < 8; r++) {
+                    if (((b >> r) & 1) && !((sim.raw[a] >> r) & 1)) sim.rise_ms[CC_SQUARE(a, r)] = ms;
+                }
+                sim.raw[a] = (uint8_t)b;
+                break;
+            case 'F':
+                sim.failed |= (uint8_t)(1 << a);
+                break;
+            case 'M':
+                sim.mask[a] = (uint8_t)b;
+                break;
+            case 'B':
+                sim.d.base[a] = sim.d.current[a] = (uint8_t)b;
+                break;
+            case 'K':
+                memset(&sim.last_move, 0, sizeof(sim.last_move));
+                if (a < 64) {
+                    sim.last_move.flags = CC_MOVE_CASTLE;
+                    sim.last_move.rook_from = (uint8_t)a;
+                    sim.last_move.rook_to = (uint8_t)b;
+                }
+                break;
+            case 'D':
+                if (rp.n_recorded < MAX_RESULTS) {
+                    outcome_t* o = &rp.recorded[rp.n_recorded++];
+                    o->ms = ms;
+                    o->result = (detect_result_t)a;
+                    o->from = o->to = o->captured = CC_NO_SQUARE;
+                }
+                break;
+            case 'V':
+                if (rp.n_recorded) {
+                    rp.recorded[rp.n_recorded - 1].from = (uint8_t)a;
+                    rp.recorded[rp.n_recorded - 1].to = (uint8_t)b;
+                }
+                break;
+            case 'X':
+                if (rp.n_recorded) rp.recorded[rp.n_recorded - 1].captured = (uint8_t)a;
+                break;
+        }
+    }
+    run_scan(&sim, &rp);
+    if (!have_snap) return 0;
+    return finish(&rp, events, exact);
+}
+
+static unsigned replay_file(FILE* f) {
+    unsigned diffs = 0;
+    // one log can hold several dumps
+    while (!feof(f)) diffs += replay(f);
+    return diffs;
+}
+
+int main(int argc, char** argv) {
+    unsigned diffs = 0;
+    if (argc < 2) return replay_file(stdin) ? 1 : 0;
+    for (int i = 1; i < argc; i++) {
+        FILE* f = fopen(argv[i], "r");
+        if (!f) {
+            perror(argv[i]);
+            return 2;
+        }
+        printf("%s\n", argv[i]);
+        diffs += replay_file(f);
+        fclose(f);
+    }
+    return diffs ? 1 : 0;
+}
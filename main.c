@@ -1,5 +1,6 @@
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 #include <stdbool.h>
 #ifndef F_CPU
 #define F_CPU 16000000UL
@@ -15,26 +16,40 @@
 #include "i2c.h"
 #include "steppermotor.h"
 #include "uart_esp.h"
+#include "trace.h"
+#include "chess_core.h"
+#include "gantry_plan.h"
+#include "checkpoint.h"
+#include "placement.h"
+#include "stepgen.h"
+#include "calibrate.h"
+#include "sensors.h"
+#include "profile.h"
+#include "sram.h"
+#include "move_detect.h"
+#include "recorder.h"
+#include "idle.h"
 
-#define NUM_MCP 8
+#define NUM_FILES 8
 #define GRAVEYARD_RANK '9'
 
-typedef enum {
-    STATE_IDLE,                 // Waiting for the first piece to be lifted
-    STATE_PIECE_LIFTED,         // One piece has been lifted
-    STATE_PIECE_CAPTURED,       // A second piece was lifted (capture scenario)
-} GameState_t;
-
 volatile bool move_ready_to_send = false;
 
-int8_t g_start_row = -1, g_start_col = -1;
-int8_t g_end_row = -1, g_end_col = -1;
-int8_t g_captured_row = -1, g_captured_col = -1;
-GameState_t g_current_state = STATE_IDLE;
+move_detector_t g_detect;         // scan state machine, src/move_detect.c
+
+// Game position as far as this board knows it: local moves and commands from the ESP
+cc_position_t g_position;
+cc_move_t g_last_move;
+uint8_t g_graveyard[8];            // piece the gantry left in each file's graveyard slot, 0 if none
+reset_plan_t g_reset_plan;
+char g_game_id[CHECKPOINT_GAME_ID_LEN + 1] = "";   // Lichess game the position belongs to, from the ESP
+checkpoint_t g_checkpoint;
+calibration_t g_calibration;
 
 // ISR variables
 volatile bool perform_scan_flag = false;
-volatile bool notmoving_flag = true;
+volatile bool notmoving_flag = true;      // false while a command from the ESP is carried out
+volatile uint32_t timer4_periods = 0;
 
 void Timer4_Init(void) {
     //cli();
@@ -51,6 +66,7 @@ void Timer4_Init(void) {
 ISR(TIMER4_COMPA_vect) {
     // This code runs every 1 seconds
     perform_scan_flag = true; 
+    timer4_periods++;
     //printf("flag set %u \n", perform_scan_flag);
 }
 
@@ -67,17 +83,49 @@ void enable_timer4_compa_interrupt(void) {
 
 void coords_to_chess_notation(int8_t row, int8_t col, char* buffer) {
     if (row >= 0 && row < 8 && col >= 0 && col < 8) {
-        // Column (File) conversion: 'a' + 0 -> 'a', 'a' + 7 -> 'h'
-        buffer[0] = 'a' + col; 
-        // Row (Rank) conversion: '1' + 0 -> '1', '1' + 7 -> '8'
-        buffer[1] = '1' + row; 
-        buffer[2] = '\0'; // Null-terminate the string
+        // MCP column = file, bit = rank
+        cc_square_name(CC_SQUARE(col, row), buffer);
     } else {
         // Handle invalid coordinates
-        strncpy(buffer, "--", 3);
+        cc_square_name(CC_NO_SQUARE, buffer);
     }
 }
 
+// Apply the move part (first 4 chars) of a move or payload to g_position.
+// Moves that don't fit the tracked position are still applied if there is a piece to move.
+bool track_move(const char* payload) {
+    char uci[5];
+    strncpy(uci, payload, 4);
+    uci[4] = '\0';
+    if (!cc_parse_uci(&g_position, uci, &g_last_move)) {
+        printf_P(PSTR("WARNING: no piece on %c%c in the tracked position\n"), uci[0], uci[1]);
+        g_last_move.flags = 0;
+        recorder_event(REC_CASTLE, CC_NO_SQUARE, CC_NO_SQUARE);
+        return false;
+    }
+    if (!cc_is_pseudo_legal(&g_position, &g_last_move)) {
+        printf_P(PSTR("WARNING: %s is not a legal move in the tracked position\n"), uci);
+    }
+    cc_apply(&g_position, &g_last_move);
+    // the scan needs this for the rook half of a castle
+    if (g_last_move.flags & CC_MOVE_CASTLE) {
+        recorder_event(REC_CASTLE, g_last_move.rook_from, g_last_move.rook_to);
+    } else {
+        recorder_event(REC_CASTLE, CC_NO_SQUARE, CC_NO_SQUARE);
+    }
+    return true;
+}
+
+// Our move is out: wait for the opponent's move over the middle of their pieces
+void start_prepositioning(void) {
+    float x, y;
+    plan_prepos_target(&g_position, g_position.side, &x, &y);
+    // printf has no float support here; the target is always a whole or half square
+    printf_P(PSTR("Pre-positioning head at x=%u.%u y=%u.%u squares\n"),
+             (unsigned)x, (unsigned)(x * 10) % 10, (unsigned)y, (unsigned)(y * 10) % 10);
+    prepos_start(x, y);
+}
+
 void format_move_string(const char* start_pos_str, const char* end_pos_str, const char* capture_pos_str, char* output_buffer) {
     // Start with the move itself
     strcpy(output_buffer, start_pos_str);
@@ -90,11 +138,12 @@ void format_move_string(const char* start_pos_str, const char* end_pos_str, cons
 }
 
 void print_gpio_matrix(uint8_t *buffer) {
-    printf("\n--Chess Board Status--\n");
+    PROFILE_BEGIN(t_print);
+    printf_P(PSTR("\n--Chess Board Status--\n"));
 
     // Print board from rank 8 down to rank 1
     for (int8_t rank = 7; rank >= 0; rank--) {
-        printf("%d| ", rank + 1);
+        printf_P(PSTR("%d| "), rank + 1);
 
         // Loop through files A -> H
         for (int8_t file = 0; file < 8; file++) {
@@ -103,27 +152,126 @@ void print_gpio_matrix(uint8_t *buffer) {
             // Check the bit for this rank
             // bit = 1 ? piece present
             if ((column_byte >> rank) & 1) {
-                printf("X ");
+                printf_P(PSTR("X "));
             } else {
-                printf(". ");
+                printf_P(PSTR(". "));
             }
         }
 
-        printf("|%d\n", rank + 1);
+        printf_P(PSTR("|%d\n"), rank + 1);
     }
 
-    printf(" ------------------- \n");
-    printf("   A B C D E F G H   \n");
+    printf_P(PSTR(" ------------------- \n"));
+    printf_P(PSTR("   A B C D E F G H   \n"));
+    PROFILE_END(PROF_PRINT_MATRIX, t_print);
 }
 
 
+// A capture command parks the taken piece in the graveyard slot of its file
+void note_graveyard(const char* input_line) {
+    if (strlen(input_line) != 6 || !(g_last_move.flags & CC_MOVE_CAPTURE)) return;
+    uint8_t file = input_line[4] - 'a';
+    if (file > 7) return;
+    if (g_graveyard[file]) {
+        printf_P(PSTR("WARNING: graveyard slot %c9 already holds a piece\n"), input_line[4]);
+    }
+    g_graveyard[file] = g_last_move.captured;
+}
+
+// Record the position, graveyard and head position in EEPROM. Called whenever they settle:
+// after a local move, after each ESP command and when pre-positioning stops. A power cut
+// in the middle of a gantry move leaves the head off by that move until the next init_pos().
+void save_checkpoint(void) {
+    checkpoint_pack(&g_checkpoint, &g_position, g_graveyard, head_x, head_y, g_game_id);
+    checkpoint_save(&g_checkpoint);
+}
+
+// Pick up the game from the EEPROM checkpoint if the pieces still stand where it says.
+// The head position is restored either way, since the gantry doesn't home at boot.
+bool resume_from_checkpoint(const uint8_t* scan) {
+    cc_position_t pos;
+    uint8_t graveyard[8];
+    char game_id[CHECKPOINT_GAME_ID_LEN + 1];
+    if (!checkpoint_load(&g_checkpoint)) {
+        printf_P(PSTR("CHECKPOINT: none saved, new game\n"));
+        return false;
+    }
+    checkpoint_unpack(&g_checkpoint, &pos, graveyard, &head_x, &head_y, game_id);
+    uint64_t occ = cc_occupancy(&pos);
+    for (uint8_t file = 0; file < NUM_FILES; file++) {
+        uint8_t expected = (uint8_t)(occ >> (8 * file));
+        if (scan[file] != expected) {
+            printf_P(PSTR("CHECKPOINT: file %c reads %02x, saved game has %02x. New game.\n"),
+                     'a' + file, scan[file], expected);
+            return false;
+        }
+    }
+    g_position = pos;
+    memcpy(g_graveyard, graveyard, sizeof(g_graveyard));
+    strcpy(g_game_id, game_id);
+    printf_P(PSTR("CHECKPOINT: resumed game %s at move %u\n"), g_game_id[0] ? g_game_id : "-", g_position.fullmove);
+    return true;
+}
+
+// "game <id>" from the ESP when it follows a game. The same id again (either side was
+// reset) keeps the tracked position; a new id starts from the initial position.
+void select_game(const char* id) {
+    if (strncmp(id, g_game_id, CHECKPOINT_GAME_ID_LEN) == 0) {
+        printf_P(PSTR("Continuing game %s\n"), g_game_id);
+        return;
+    }
+    strncpy(g_game_id, id, CHECKPOINT_GAME_ID_LEN);
+    g_game_id[CHECKPOINT_GAME_ID_LEN] = '\0';
+    printf_P(PSTR("New game %s\n"), g_game_id);
+    cc_position_start(&g_position);
+    memset(g_graveyard, 0, sizeof(g_graveyard));
+    g_last_move.flags = 0;
+}
+
+// The scan shows exactly the squares occ has; the first file that doesn't is reported
+bool board_matches(const uint8_t* scan, uint64_t occ, const char* who) {
+    for (uint8_t file = 0; file < NUM_FILES; file++) {
+        uint8_t expected = (uint8_t)(occ >> (8 * file));
+        if (scan[file] != expected) {
+            printf_P(PSTR("%s: file %c reads %02x, expected %02x. Fix the board and retry.\n"),
+                     who, 'a' + file, scan[file], expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Put every piece back on its start square. The sensors must agree with the tracked
+// position first, since the plan trusts it for which piece stands where.
+void run_board_reset(const uint8_t* scan) {
+    if (!board_matches(scan, cc_occupancy(&g_position), "RESET")) return;
+    if (!plan_reset(&g_position, g_graveyard, true, &g_reset_plan)) {
+        printf_P(PSTR("RESET: no plan found\n"));
+        return;
+    }
+    printf_P(PSTR("RESET: %u moves, ~%u s of travel\n"), g_reset_plan.count, (unsigned)plan_reset_cost_s(&g_reset_plan));
+
+    char cmd[5];
+    for (uint8_t i = 0; i < g_reset_plan.count; i++) {
+        plan_square_name(g_reset_plan.moves[i].from, cmd);
+        plan_square_name(g_reset_plan.moves[i].to, cmd + 2);
+        printf_P(PSTR("RESET: %s\n"), cmd);
+        place_piece(cmd);
+    }
+    if (g_reset_plan.missing) printf_P(PSTR("RESET: %u pieces missing, place them by hand\n"), g_reset_plan.missing);
+    if (g_reset_plan.extras) printf_P(PSTR("RESET: %u extra pieces left on ranks 3-6\n"), g_reset_plan.extras);
+    cc_position_start(&g_position);
+    memset(g_graveyard, 0, sizeof(g_graveyard));
+    g_last_move.flags = 0;
+}
+
 void process_chess_command(char* input_line) {
     size_t len = strlen(input_line);
     char cmd_buffer[5]; // 4 chars + null terminator
     // CASE 1: Normal Move (e.g., "e2e4") - Length 4
     //init_pos();
     if (len == 4) {
-        move_motor(input_line);
+        place_piece(input_line);
     }
 
     // CASE 2: Capture (e.g., "e5d6d5") - Length 6
@@ -140,12 +288,12 @@ void process_chess_command(char* input_line) {
         
         cmd_buffer[4] = '\0'; 
         
-        move_motor(cmd_buffer);
+        place_piece(cmd_buffer);
         // Copy the first 4 chars (e.g., "e5d6")
         strncpy(cmd_buffer, input_line, 4);
         cmd_buffer[4] = '\0';
         
-        move_motor(cmd_buffer);
+        place_piece(cmd_buffer);
     }
 
     // CASE 3: Castle (e.g., "e1g1h1f1") - Length 8
@@ -153,217 +301,380 @@ void process_chess_command(char* input_line) {
         // Move the King (First 4 chars)
         strncpy(cmd_buffer, input_line, 4);
         cmd_buffer[4] = '\0';
-        move_motor(cmd_buffer);
+        place_piece(cmd_buffer);
 
         // Move the Rook (Last 4 chars)
         strncpy(cmd_buffer, input_line + 4, 4);
         cmd_buffer[4] = '\0';
-        move_motor(cmd_buffer);
+        place_piece(cmd_buffer);
+    }
+}
+
+void esp_send_line(const char* line) {
+    uart1_send_string(line);
+    uart1_send_byte('\n');
+}
+
+void esp_send_line_P(const char* line) {
+    uart1_send_string_P(line);
+    uart1_send_byte('\n');
+}
+
+// Hardware replay for throughput measurements: "replay" starts a game from the initial
+// position, each "rp <payload>" is then carried out like a streamed move and answered
+// with "rp:<n> <payload> <ms> <failed placements> <squares off>" once the gantry is done
+// and the whole board has been read back; "replay end" answers
+// "rp:done <moves> <total ms> <max ms> <failed placements> <moves with squares off>".
+// The ESP feeds the moves (from a PGN or UCI list) one per answer.
+typedef struct {
+    bool active;
+    uint16_t moves;
+    uint16_t failed;            // placements still wrong after their retries
+    uint16_t off;               // moves after which the board didn't read as the position
+    uint32_t total_ms;
+    uint32_t max_ms;
+} replay_stats_t;
+
+replay_stats_t g_replay;
+
+void replay_start(const uint8_t* scan) {
+    cc_position_t start;
+    cc_position_start(&start);
+    if (!board_matches(scan, cc_occupancy(&start), "REPLAY")) {
+        esp_send_line_P(PSTR("rp:error board not in the start position"));
+        return;
+    }
+    memset(&g_replay, 0, sizeof(g_replay));
+    g_replay.active = true;
+    // the replay is no game of the ESP's; "game <id>" starts over from the start position
+    g_game_id[0] = '\0';
+    g_position = start;
+    memset(g_graveyard, 0, sizeof(g_graveyard));
+    g_last_move.flags = 0;
+    printf_P(PSTR("REPLAY: started\n"));
+    esp_send_line_P(PSTR("rp:start"));
+}
+
+void replay_move(char* payload) {
+    char buf[48];
+    if (!g_replay.active) {
+        esp_send_line_P(PSTR("rp:error not started"));
+        return;
+    }
+    uint16_t failed = placement_stats.failed;
+    uint32_t t0 = trace_now_us();
+    track_move(payload);
+    note_graveyard(payload);
+    process_chess_command(payload);
+    uint32_t ms = (trace_now_us() - t0) / 1000;
+
+    // read the whole board back: anything the placement check of the moved squares missed
+    uint8_t columns[8];
+    uint8_t unread = sensors_read(SENSOR_ALL_FILES, columns);
+    uint64_t occ = cc_occupancy(&g_position);
+    uint8_t off = 0;
+    for (uint8_t file = 0; file < NUM_FILES; file++) {
+        if ((unread >> file) & 1) continue;
+        for (uint8_t diff = columns[file] ^ (uint8_t)(occ >> (8 * file)); diff; diff &= (uint8_t)(diff - 1)) off++;
+    }
+
+    failed = placement_stats.failed - failed;
+    g_replay.moves++;
+    g_replay.failed += failed;
+    if (off) g_replay.off++;
+    g_replay.total_ms += ms;
+    if (ms > g_replay.max_ms) g_replay.max_ms = ms;
+    snprintf_P(buf, sizeof(buf), PSTR("rp:%u %s %lu %u %u"), g_replay.moves, payload, (unsigned long)ms, failed, off);
+    printf_P(PSTR("REPLAY: %s\n"), buf + 3);
+    esp_send_line(buf);
+}
+
+void replay_end(void) {
+    char buf[48];
+    g_replay.active = false;
+    snprintf_P(buf, sizeof(buf), PSTR("rp:done %u %lu %lu %u %u"), g_replay.moves, (unsigned long)g_replay.total_ms,
+               (unsigned long)g_replay.max_ms, g_replay.failed, g_replay.off);
+    printf_P(PSTR("REPLAY: %s\n"), buf + 3);
+    esp_send_line(buf);
+}
+
+// "occ <tag>" from the ESP: answer "oc:<tag> <occupancy> <state>" with the board as the
+// move detection last settled it (one hex byte per file, bit = rank) and its state, so the
+// ESP can check it against the game it follows. Only STATE_IDLE means no move is underway.
+void report_occupancy(const char* tag) {
+    char buf[48];
+    int n = snprintf_P(buf, sizeof(buf), PSTR("oc:%s "), tag);
+    for (uint8_t file = 0; file < NUM_FILES; file++) {
+        sprintf_P(buf + n + 2 * file, PSTR("%02x"), g_detect.base[file]);
+    }
+    sprintf_P(buf + n + 16, PSTR(" %u"), g_detect.state);
+    esp_send_line(buf);
+}
+
+// "fix <from><to>" from the ESP: a corrective gantry move that brings the pieces back in
+// line with the game. The tracked position already has the piece on <to>, so it is left alone.
+void run_fix_move(const char* squares) {
+    if (strlen(squares) != 4 || cc_parse_square(squares) == CC_NO_SQUARE ||
+        cc_parse_square(squares + 2) == CC_NO_SQUARE) {
+        printf_P(PSTR("FIX: bad squares %s\n"), squares);
+        return;
+    }
+    printf_P(PSTR("FIX: %s\n"), squares);
+    place_piece(squares);
+}
+
+// Commands that only report. They leave pre-positioning running and move nothing, so
+// there is nothing to reconcile or checkpoint after them.
+bool run_query(const char* line) {
+    if (strcmp_P(line, PSTR("prof")) == 0) {
+        profile_report();
+        idle_report();
+    } else if (strcmp_P(line, PSTR("mem")) == 0) {
+        sram_report();
+    } else if (strcmp_P(line, PSTR("rec")) == 0) {
+        recorder_dump();
+    } else if (strcmp_P(line, PSTR("rec clear")) == 0) {
+        uint8_t columns[8];
+        sensors_read(SENSOR_ALL_FILES, columns);
+        recorder_clear(&g_detect, columns, motion_mask);
+    } else if (strcmp_P(line, PSTR("replay end")) == 0) {
+        replay_end();
+    } else if (strncmp_P(line, PSTR("occ "), 4) == 0) {
+        report_occupancy(line + 4);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Once the gantry has stopped, read the columns its moves disturbed in one pass. Those
+// squares take the sensor reading as the new base state; any that disagree with the
+// tracked position are reported rather than fed to the move detection.
+void reconcile_after_motion(void) {
+    uint64_t occ = cc_occupancy(&g_position);
+    uint8_t files = 0;
+    uint8_t columns[8];
+    for (uint8_t file = 0; file < NUM_FILES; file++) {
+        if (motion_mask[file]) files |= (uint8_t)(1 << file);
+    }
+    uint8_t failed = files ? sensors_read(files, columns) : 0;
+    for (uint8_t file = 0; file < NUM_FILES; file++) {
+        uint8_t mask = motion_mask[file];
+        if (!mask || ((failed >> file) & 1)) continue;
+        uint8_t data = columns[file];
+        uint8_t off = (data ^ (uint8_t)(occ >> (8 * file))) & mask;
+        if (off) {
+            printf_P(PSTR("RECONCILE: file %c rank bits %02x differ from the tracked position\n"), 'a' + file, off);
+        }
+        g_detect.base[file] = (g_detect.base[file] & ~mask) | (data & mask);
+        g_detect.current[file] = g_detect.base[file];
+        recorder_event(REC_BASE, file, g_detect.base[file]);
+    }
+    motion_mask_clear();
+}
+
+// Scan the hardware and run the move detection state machine (src/move_detect.c) on it.
+// Runs from the main loop and, through the motion poll, while the gantry moves.
+void scan_board(void) {
+    char start_pos_str[3];
+    char end_pos_str[3];
+    char capture_pos_str[3];
+    char move_string_buffer[8];
+    uint16_t seq;
+    PROFILE_BEGIN(t_scan);
+
+    perform_scan_flag = false;
+    // Scan the hardware and run it through the move detection
+    uint8_t columns[8];
+    uint8_t failed = sensors_read(SENSOR_ALL_FILES, columns);
+    recorder_scan(columns, failed, motion_mask);
+    detect_result_t result = move_detect_scan(&g_detect, columns, failed, motion_mask, &g_last_move);
+    recorder_result(result, &g_detect);
+
+    switch (result) {
+        case DETECT_NONE:
+            break;
+        case DETECT_LIFTED:
+            coords_to_chess_notation(g_detect.start_row, g_detect.start_col, start_pos_str);
+            printf_P(PSTR("STATE: Piece lifted at %s. Waiting for placement/capture.\n"), start_pos_str);
+            print_gpio_matrix(g_detect.current);
+            break;
+        case DETECT_ADDED:
+            print_gpio_matrix(g_detect.current);
+            break;
+        case DETECT_ROOK:
+            printf_P(PSTR("STATE: Castling rook placed.\n"));
+            g_last_move.flags = 0;
+            print_gpio_matrix(g_detect.current);
+            break;
+        case DETECT_RETURNED:
+            printf_P(PSTR("INFO: Piece returned to original position. Back to IDLE.\n"));
+            print_gpio_matrix(g_detect.current);
+            break;
+        case DETECT_SECOND_LIFT:
+            coords_to_chess_notation(g_detect.captured_row, g_detect.captured_col, capture_pos_str);
+            printf_P(PSTR("STATE: Second piece lifted (Capture detected at %s).\n"), capture_pos_str);
+            print_gpio_matrix(g_detect.current);
+            break;
+        case DETECT_AMBIGUOUS:
+            printf_P(PSTR("INFO: Ambiguous changes or noise while waiting for move completion. Resetting state.\n"));
+            print_gpio_matrix(g_detect.current);
+            break;
+        case DETECT_MOVE:
+        case DETECT_CAPTURE:
+            seq = trace_next_local_seq();
+            trace_mark(seq, PSTR("a.scan"));
+            coords_to_chess_notation(g_detect.start_row, g_detect.start_col, start_pos_str);
+            coords_to_chess_notation(g_detect.end_row, g_detect.end_col, end_pos_str);
+            if (result == DETECT_CAPTURE) {
+                coords_to_chess_notation(g_detect.captured_row, g_detect.captured_col, capture_pos_str);
+            }
+            format_move_string(start_pos_str, end_pos_str, result == DETECT_CAPTURE ? capture_pos_str : NULL,
+                               move_string_buffer);
+            track_move(move_string_buffer);
+            // TX move to ESP HERE
+            trace_send_move(move_string_buffer, seq);
+            trace_mark(seq, PSTR("a.tx"));
+            if (result == DETECT_CAPTURE) {
+                printf_P(PSTR("STATE: Capture Move Complete. Move: %s\n"), move_string_buffer);
+            } else {
+                printf_P(PSTR("STATE: Standard Move Complete! Move: %s\n"), move_string_buffer);
+            }
+            trace_flush();
+            save_checkpoint();
+            if (notmoving_flag) start_prepositioning();
+            print_gpio_matrix(g_detect.current);
+            break;
+    }
+    PROFILE_END(PROF_SCAN, t_scan);
+}
+
+// Log the step ISR's worst case whenever it grows
+void report_step_isr_budget(void) {
+    static uint16_t reported = 0;
+    uint16_t worst = stepgen_isr_max_cycles();
+    if (worst > reported) {
+        printf_P(PSTR("STEP ISR: worst %u cycles of %lu per tick\n"), worst, (unsigned long)stepgen_cycles_per_tick());
+        reported = worst;
+    }
+}
+
+// Called while the gantry waits on its timers: keep scanning the rest of the board
+void scan_while_moving(void) {
+    if (perform_scan_flag) {
+        scan_board();
     }
 }
 
 int main(void) {
     //cli();
     uart_init();
-    printf("serial print uart init\n");
+    printf_P(PSTR("serial print uart init\n"));
     uart1_init();
-    printf("serial coms to ESP started\n");
+    printf_P(PSTR("serial coms to ESP started\n"));
     Timer4_Init();
-    printf("timer4 init\n");
+    printf_P(PSTR("timer4 init\n"));
+    profile_init();
+    idle_init();
     TWI_init();
-    printf("TWI init\n");
+    printf_P(PSTR("TWI init\n"));
     motor_init();
+    if (calibration_load(&g_calibration)) {
+        motion_set_scale(g_calibration.steps_per_square_x, g_calibration.steps_per_square_y,
+                         g_calibration.backlash_x, g_calibration.backlash_y);
+        printf_P(PSTR("Axis calibration loaded\n"));
+    } else {
+        printf_P(PSTR("No axis calibration, using nominal scale. Send \"calibrate\" with the board empty.\n"));
+    }
     //init_pos();
-    printf("init\n");
+    printf_P(PSTR("init\n"));
     
     // sei();
     // init_pos();
-    printf("motor init\n");
-    uint8_t board_status_buffer[8] = {0xFF};       // Current state
-    uint8_t base_board_state[8] = {0xFF};      // The state after the last *validated* move
-
-    twi_error_t status;
-    twi_error_t read_status;
+    printf_P(PSTR("motor init\n"));
     
     //int8_t captured_piece_row = -1, captured_piece_col = -1; // Track the captured piece location
 
-    print_gpio_matrix(&board_status_buffer);
     // GPIO expander initialization
-    for (uint8_t i = 0; i < NUM_MCP; i++) {
-        status = initialize_mcp23008_inputs(i);
-        if (status != TWI_SUCCESS) {
-            // Handle initialization error (e.g., LED warning)
-            printf("ERROR: on chip %u, status: %u\n", i, status);
-            DDRB |= (1 << PB5); 
-            PORTB |= (1 << PB5); 
-        } else {
-            printf("TWI on %u START SUCESS\n", i);
-        }
+    if (!sensors_init()) {
+        // Handle initialization error (e.g., LED warning)
+        DDRB |= (1 << PB5); 
+        PORTB |= (1 << PB5); 
     }
     
     // Perform an initial scan to populate the old buffer before the loop starts
-    for (uint8_t j = 0; j < NUM_MCP; j++) {
-        uint8_t data = (mcp_read_register(j, MCP23008_GPIO_REG, &status));
-        if (status == TWI_SUCCESS) {
-            base_board_state[j] = data;
-        } else {
-            base_board_state[j] = 0xAA; // Use an error placeholder pattern
+    uint8_t initial[8];
+    uint8_t failed = sensors_read(SENSOR_ALL_FILES, initial);
+    for (uint8_t j = 0; j < NUM_FILES; j++) {
+        if ((failed >> j) & 1) {
+            initial[j] = 0xAA; // Use an error placeholder pattern
         }
     }
-    memcpy(&board_status_buffer, &base_board_state, sizeof(base_board_state));
+    move_detect_reset(&g_detect, initial);
+    recorder_clear(&g_detect, initial, motion_mask);
     
-    printf("Initial board state captured.\n");
-    print_gpio_matrix(&board_status_buffer);
+    printf_P(PSTR("Initial board state captured.\n"));
+    print_gpio_matrix(g_detect.current);
     
-    char start_pos_str[3];
-    char end_pos_str[3];
-    char capture_pos_str[3];
-    char move_string_buffer[8];
     char line[64];
-    g_current_state = STATE_IDLE;
+    motion_set_poll(scan_while_moving);
+    sram_report();
+    if (!resume_from_checkpoint(g_detect.base)) {
+        cc_position_start(&g_position);
+        memset(g_graveyard, 0, sizeof(g_graveyard));
+    }
     sei();
     while (1) {
         
         if (uart1_readline(line, sizeof(line))) {
-        //    disable_timer4_compa_interrupt;
-            printf("Received from ESP32: %s\n", line);
-        //    process_chess_command(line);
-        //    enable_timer4_compa_interrupt;
-        }
-        
-        if (perform_scan_flag && notmoving_flag) {
-            // pause interrupts. printing can take time.
-            perform_scan_flag = false;
-            // Scan the hardware and populate board_status_buffer
-            int8_t current_scan_removed_count = 0;
-            int8_t current_scan_added_count = 0;
-            int8_t observed_removed_row = -1, observed_removed_col = -1;
-            int8_t observed_added_row = -1, observed_added_col = -1;
-            uint8_t col = 0;
-            uint8_t diff = 0x00;
-            for (col = 0; col < NUM_MCP; col++) {
-                uint8_t data = (mcp_read_register(col, MCP23008_GPIO_REG, &read_status));
-                if (read_status == TWI_SUCCESS) {
-                    diff = data ^ base_board_state[col] ;
-                    if (diff > 0) {
-                        for (uint8_t row = 0; row < 8; row++) {
-                            if ((diff >> row) & 1) {
-                                if ((base_board_state[col] >> row) & 1) {
-                                    current_scan_removed_count++;
-                                    observed_removed_row = row;
-                                    observed_removed_col = col;
-                                } else {
-                                    current_scan_added_count++;
-                                    observed_added_row = row;
-                                    observed_added_col = col;
-                                }
-                            }
-                        }
-                    }
-                    board_status_buffer[col] = data;
-                }
+            uint16_t seq = trace_take_seq(line);
+            trace_mark(seq, PSTR("a.rx"));
+            printf_P(PSTR("Received from ESP32: %s\n"), line);
+            if (run_query(line)) {
+                continue;
             }
-            // printf("%u\n",diff);
-            //if (current_scan_removed_count != 0 || current_scan_added_count !=0) {
-            //    printf("removed: %u, added %u \n",current_scan_removed_count,current_scan_added_count);
-            //}
-            //printf("removed: %u, added %u \n",current_scan_removed_count,current_scan_added_count);
-            switch (g_current_state) {
-                case STATE_IDLE:
-                    // Look for exactly one piece being lifted from the base state
-                    if (current_scan_removed_count == 1 && current_scan_added_count == 0) {
-                        g_start_row = observed_removed_row;
-                        g_start_col = observed_removed_col;
-                        g_current_state = STATE_PIECE_LIFTED;
-                        coords_to_chess_notation(g_start_row, g_start_col, start_pos_str);
-                        
-                        printf("STATE: Piece lifted at %s. Waiting for placement/capture.\n", start_pos_str);
-                        print_gpio_matrix(&board_status_buffer);
-                    } else if (current_scan_added_count > 0) {
-                        print_gpio_matrix(&board_status_buffer);
-                        memcpy(&base_board_state, &board_status_buffer, sizeof(board_status_buffer));
-                    }
-                    break;
-                case STATE_PIECE_LIFTED:
-                    if (current_scan_added_count == 1 && current_scan_removed_count == 1) {
-                        // A single piece was placed back down (standard move completion)
-                        g_end_row = observed_added_row;
-                        g_end_col = observed_added_col;
-                        if (g_start_row != g_end_row || g_start_col != g_end_col) {
-                            coords_to_chess_notation(g_start_row, g_start_col, start_pos_str);
-                            coords_to_chess_notation(g_end_row, g_end_col, end_pos_str);
-                            
-                            format_move_string(start_pos_str, end_pos_str, NULL, move_string_buffer);
-                            printf("STATE: Standard Move Complete! Move: %s\n", move_string_buffer);
-                            // TX move to ESP HERE
-                            uart1_send_string(move_string_buffer);
-                                    
-                            g_current_state = STATE_IDLE;
-                            print_gpio_matrix(&board_status_buffer);
-                            memcpy(&base_board_state, &board_status_buffer, sizeof(board_status_buffer));
-                        } else {
-                            printf("INFO: Piece returned to original position. Back to IDLE.\n");
-                            g_current_state = STATE_IDLE;
-                        }
-                        print_gpio_matrix(&board_status_buffer);
-                        memcpy(&base_board_state, &board_status_buffer, sizeof(board_status_buffer));
-                    } else if (current_scan_removed_count == 2 && current_scan_added_count == 0) {
-                        // A second piece was lifted before the first was placed (a capture scenario start)
-                        g_captured_row = observed_removed_row;
-                        g_captured_col = observed_removed_col;
-                        coords_to_chess_notation(g_captured_row, g_captured_col, capture_pos_str);
-                        printf("STATE: Second piece lifted (Capture detected at %s).\n", capture_pos_str);
-                        g_current_state = STATE_PIECE_CAPTURED;
-                        print_gpio_matrix(&board_status_buffer);
-                        memcpy(&base_board_state, &board_status_buffer, sizeof(board_status_buffer));
-                        
-
-                    } else if (current_scan_added_count > 1 || current_scan_removed_count > 2) {
-                        // Multiple ambiguous changes, reset state machine for safety
-                        printf("INFO: Ambiguous changes or noise while waiting for move completion. Resetting state.\n");
-                        g_current_state = STATE_IDLE;
-                        // Force a resync of the base state to the current physical state, abandoning partial moves.
-                        print_gpio_matrix(&board_status_buffer);
-                        memcpy(&base_board_state, &board_status_buffer, sizeof(board_status_buffer));
-                    } else {
-                        //printf("STATE: PIECE_LIFTED \n");
-                    }
-                    break;
-                case STATE_PIECE_CAPTURED:
-                    //printf("removed: %u, added %u \n",current_scan_removed_count,current_scan_added_count);
-            
-                    // We are waiting ONLY for a single piece to be placed back down
-                    if (current_scan_added_count == 1 && current_scan_removed_count == 0) {
-                        // The move is finished
-                        g_end_row = observed_added_row;
-                        g_end_col = observed_added_col;
-
-                        coords_to_chess_notation(g_start_row, g_start_col, start_pos_str);
-                        coords_to_chess_notation(g_end_row, g_end_col, end_pos_str);
-                        coords_to_chess_notation(g_captured_row, g_captured_col, capture_pos_str);
-                        
-                        format_move_string(start_pos_str, end_pos_str, capture_pos_str, move_string_buffer);
-                        printf("STATE: Capture Move Complete. Move: %s\n", move_string_buffer);
-                        
-                        // TX move to ESP HERE
-                        uart1_send_string(move_string_buffer);
-                        g_current_state = STATE_IDLE;
-                        g_captured_row = -1; g_captured_col = -1;
-                        g_start_row = -1; g_start_col = -1;
-                        g_end_row = -1; g_end_col = -1;
-                        
-                        // Sync the base state to the new board layout
-                        print_gpio_matrix(&board_status_buffer);
-                        memcpy(&base_board_state, &board_status_buffer, sizeof(board_status_buffer));
-                    } else {
-                        //printf("STATE: PIECE_CAPTURED \n");
-                    }
-                    break;
-                // case statement end
+            prepos_cancel();
+            notmoving_flag = false;
+            if (strcmp_P(line, PSTR("reset")) == 0) {
+                run_board_reset(g_detect.current);
+            } else if (strcmp_P(line, PSTR("calibrate")) == 0) {
+                calibrate_axes(&g_calibration);
+            } else if (strcmp_P(line, PSTR("replay")) == 0) {
+                replay_start(g_detect.current);
+            } else if (strncmp_P(line, PSTR("rp "), 3) == 0) {
+                replay_move(line + 3);
+            } else if (strncmp_P(line, PSTR("fix "), 4) == 0) {
+                run_fix_move(line + 4);
+            } else if (strncmp_P(line, PSTR("game "), 5) == 0) {
+                select_game(line + 5);
+            } else {
+                track_move(line);
+                note_graveyard(line);
+                trace_mark(seq, PSTR("a.start"));
+                process_chess_command(line);
+                trace_mark(seq, PSTR("a.end"));
             }
-            // print_gpio_matrix(&board_status_buffer);
+            reconcile_after_motion();
+            report_step_isr_budget();
+            notmoving_flag = true;
+            trace_flush();
+            save_checkpoint();
         }
         
+        bool was_prepositioning = prepos_active();
+        prepos_service();
+        if (was_prepositioning && !prepos_active()) {
+            save_checkpoint();
+        }
+
+        if (perform_scan_flag) {
+            idle_scan_started();
+            scan_board();
+        }
+
+        // sleep until an interrupt, unless one has already left work for the next pass
+        cli();
+        idle_wait(perform_scan_flag || uart1_rx_pending() || (prepos_active() && !stepgen_busy()));
     }
     
     return 0;
@@ -0,0 +1,156 @@
+#include "calibrate.h"
+#include "checkpoint.h"
+#include "magnet.h"
+#include "sensors.h"
+#include "stepgen.h"
+#include "steppermotor.h"
+#include <avr/eeprom.h>
+#include <avr/pgmspace.h>
+#include <util/crc16.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CALIBRATION_VERSION 1
+// Stored after the checkpoint ring
+#define CALIBRATION_ADDR ((void*)(uintptr_t)(CHECKPOINT_SLOTS * CHECKPOINT_SLOT_SIZE))
+
+#define CAL_CHUNK 2             // axis steps between sensor reads
+#define CAL_NEAR 1              // watched squares, in head coordinates along the axis
+#define CAL_FAR 6
+#define CAL_SWEEP 7             // squares swept, at the nominal scale
+#define CAL_TOLERANCE 0.2f      // a result this far from the nominal scale is rejected
+
+typedef enum {
+    AXIS_X,
+    AXIS_Y,
+} axis_t;
+
+typedef char calibration_fits[(CHECKPOINT_SLOTS * CHECKPOINT_SLOT_SIZE + sizeof(calibration_t) <= 1024) ? 1 : -1];
+
+static uint8_t calibration_crc(const calibration_t* cal) {
+    const uint8_t* p = (const uint8_t*)cal;
+    uint8_t crc = 0xFF;
+    for (uint8_t i = 0; i < offsetof(calibration_t, crc); i++) {
+        crc = _crc8_ccitt_update(crc, p[i]);
+    }
+    return crc;
+}
+
+bool calibration_load(calibration_t* cal) {
+    eeprom_read_block(cal, CALIBRATION_ADDR, sizeof(*cal));
+    return cal->version == CALIBRATION_VERSION && cal->crc == calibration_crc(cal);
+}
+
+// One chunk along an axis. +y (toward rank 1) turns motor 1 back and motor 2 forward.
+static void axis_step(axis_t axis, int16_t steps) {
+    if (axis == AXIS_X) stepgen_move(steps, steps);
+    else stepgen_move((int16_t)-steps, steps);
+    wait_stop_1();
+}
+
+// Sweep `steps` along the axis with the magnet on, reading the two watched squares after
+// every chunk. centre[i] is the midpoint between where square i's switch closed and
+// opened again, as a position in steps from where the calibration started (*pos).
+static bool sweep(axis_t axis, int16_t steps, int16_t* pos, const uint8_t file[2],
+                  const uint8_t bit[2], float centre[2]) {
+    int16_t rise[2], fall[2];
+    uint8_t seen[2] = {0, 0};       // 1: closed, 2: closed and open again
+    int16_t dir = steps > 0 ? CAL_CHUNK : -CAL_CHUNK;
+    uint8_t files = (uint8_t)((1 << file[0]) | (1 << file[1]));
+    uint8_t columns[8];
+
+    for (int16_t done = 0; done < (steps > 0 ? steps : -steps); done += CAL_CHUNK) {
+        axis_step(axis, dir);
+        *pos += dir;
+        if (sensors_read(files, columns)) return false;
+        for (uint8_t i = 0; i < 2; i++) {
+            uint8_t closed = (columns[file[i]] >> bit[i]) & 1;
+            if (closed && seen[i] == 0) {
+                rise[i] = *pos;
+                seen[i] = 1;
+            } else if (!closed && seen[i] == 1) {
+                fall[i] = *pos;
+                seen[i] = 2;
+            }
+        }
+    }
+    for (uint8_t i = 0; i < 2; i++) {
+        if (seen[i] != 2) return false;
+        centre[i] = (rise[i] + fall[i]) / 2.0f;
+    }
+    return true;
+}
+
+// Forward then back across the watched squares; the head ends where it started
+static bool calibrate_axis(axis_t axis, float nominal, const uint8_t file[2], const uint8_t bit[2],
+                           float* steps_per_square, uint8_t* backlash) {
+    float forward[2], back[2];
+    int16_t pos = 0;
+    int16_t span = (int16_t)(CAL_SWEEP * nominal);
+
+    magnet_on();
+    bool ok = sweep(axis, span, &pos, file, bit, forward) &&
+              sweep(axis, (int16_t)-span, &pos, file, bit, back);
+    magnet_off();
+    if (!ok) {
+        printf_P(PSTR("CALIBRATE: %c axis, a watched square never switched\n"), axis == AXIS_X ? 'x' : 'y');
+        return false;
+    }
+
+    float scale = ((forward[1] - forward[0]) + (back[1] - back[0])) / 2.0f / (CAL_FAR - CAL_NEAR);
+    float lash = ((forward[0] - back[0]) + (forward[1] - back[1])) / 2.0f;
+    printf_P(PSTR("CALIBRATE: %c axis %u.%02u steps/square, backlash %u steps\n"), axis == AXIS_X ? 'x' : 'y',
+             (unsigned)scale, (unsigned)(scale * 100) % 100, (unsigned)(lash > 0 ? lash + 0.5f : 0));
+    if (scale < nominal * (1 - CAL_TOLERANCE) || scale > nominal * (1 + CAL_TOLERANCE)) {
+        printf_P(PSTR("CALIBRATE: rejected, too far from %u steps/square\n"), (unsigned)nominal);
+        return false;
+    }
+    *steps_per_square = scale;
+    *backlash = lash <= 0 ? 0 : lash >= 255 ? 255 : (uint8_t)(lash + 0.5f);
+    return true;
+}
+
+// Measure both axes, store the result and switch the motion code over to it. The board
+// must be empty: the magnet would drag pieces, and an occupied square's switch is closed
+// anyway. Leaves the head homed.
+bool calibrate_axes(calibration_t* cal) {
+    uint8_t columns[8];
+    uint8_t failed = sensors_read(SENSOR_ALL_FILES, columns);
+    for (uint8_t file = 0; file < 8; file++) {
+        if (((failed >> file) & 1) || columns[file]) {
+            printf_P(PSTR("CALIBRATE: clear the board first (file %c reads %02x)\n"), 'a' + file, columns[file]);
+            return false;
+        }
+    }
+    // the magnet closes switches all along the sweeps; none of it is a player move
+    memset(motion_mask, 0xFF, sizeof(motion_mask));
+
+    calibration_t result;
+    result.version = CALIBRATION_VERSION;
+
+    // x: along rank 5 (head y = 3), watching b5 and g5
+    static const uint8_t x_file[2] = {CAL_NEAR, CAL_FAR};
+    static const uint8_t x_bit[2] = {4, 4};
+    // y: down the d file (head x = 3), watching d7 and d2
+    static const uint8_t y_file[2] = {3, 3};
+    static const uint8_t y_bit[2] = {7 - CAL_NEAR, 7 - CAL_FAR};
+
+    init_pos();
+    xy_move(0, 3);
+    wait_stop_1();
+    bool ok = calibrate_axis(AXIS_X, STEPS_PER_SQUARE_X, x_file, x_bit, &result.steps_per_square_x, &result.backlash_x);
+    if (ok) {
+        xy_move(3, -3);
+        wait_stop_1();
+        ok = calibrate_axis(AXIS_Y, STEPS_PER_SQUARE_Y, y_file, y_bit, &result.steps_per_square_y, &result.backlash_y);
+    }
+    init_pos();
+    if (!ok) return false;
+
+    result.crc = calibration_crc(&result);
+    eeprom_update_block(&result, CALIBRATION_ADDR, sizeof(result));
+    motion_set_scale(result.steps_per_square_x, result.steps_per_square_y, result.backlash_x, result.backlash_y);
+    *cal = result;
+    return true;
+}
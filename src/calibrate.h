@@ -0,0 +1,27 @@
+#ifndef CALIBRATE_H
+#define CALIBRATE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Axis scale and backlash, measured on the machine. Each axis has one limit switch, so
+// init_pos() gives the origin and the reed switches give the far reference: with the
+// magnet on, an empty square's switch closes while the head passes under it. Sweeping
+// across two squares five apart gives steps per square from the distance between their
+// centres; sweeping back gives the backlash as the shift of the same centres. Reed switch
+// hysteresis is symmetric, so it drops out of both. Needs an empty board.
+//
+// Steps are axis steps: one step of each motor (same way for x, opposite ways for y).
+typedef struct {
+    uint16_t version;
+    float steps_per_square_x;
+    float steps_per_square_y;
+    uint8_t backlash_x;         // steps taken up on a reversal before the head moves
+    uint8_t backlash_y;
+    uint8_t crc;
+} calibration_t;
+
+bool calibration_load(calibration_t* cal);
+bool calibrate_axes(calibration_t* cal);
+
+#endif
@@ -0,0 +1,94 @@
+#include "checkpoint.h"
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+#include <stddef.h>
+#include <string.h>
+
+// The record has to fit its slot; a negative array size stops the build if it grows
+typedef char checkpoint_fits_slot[(sizeof(checkpoint_t) <= CHECKPOINT_SLOT_SIZE) ? 1 : -1];
+
+#define CHECKPOINT_ADDR(slot) ((void*)(uintptr_t)((slot) * CHECKPOINT_SLOT_SIZE))
+
+static uint8_t next_slot = 0;
+static uint16_t last_seq = 0;
+
+// Starts from 0xFF so neither an erased (all 0xFF) nor a zeroed slot has a matching CRC
+static uint8_t checkpoint_crc(const checkpoint_t* cp) {
+    const uint8_t* p = (const uint8_t*)cp;
+    uint8_t crc = 0xFF;
+    for (uint8_t i = 0; i < offsetof(checkpoint_t, crc); i++) {
+        crc = _crc8_ccitt_update(crc, p[i]);
+    }
+    return crc;
+}
+
+static int16_t to_hundredths(float v) {
+    return (int16_t)(v >= 0 ? v * 100 + 0.5f : v * 100 - 0.5f);
+}
+
+void checkpoint_pack(checkpoint_t* cp, const cc_position_t* pos, const uint8_t graveyard[8],
+                     float head_x, float head_y, const char* game_id) {
+    memset(cp, 0, sizeof(*cp));
+    strncpy(cp->game_id, game_id, CHECKPOINT_GAME_ID_LEN);
+    for (uint8_t sq = 0; sq < 64; sq += 2) {
+        cp->board[sq / 2] = cc_piece_at(pos, sq) | (cc_piece_at(pos, sq + 1) << 4);
+    }
+    cp->side_castling = (uint8_t)(pos->side << 4) | (pos->castling & 0x0F);
+    cp->ep = pos->ep;
+    cp->halfmove = pos->halfmove;
+    cp->fullmove = pos->fullmove;
+    for (uint8_t f = 0; f < 8; f += 2) {
+        cp->graveyard[f / 2] = graveyard[f] | (graveyard[f + 1] << 4);
+    }
+    cp->head_x = to_hundredths(head_x);
+    cp->head_y = to_hundredths(head_y);
+}
+
+void checkpoint_unpack(const checkpoint_t* cp, cc_position_t* pos, uint8_t graveyard[8],
+                       float* head_x, float* head_y, char game_id[CHECKPOINT_GAME_ID_LEN + 1]) {
+    memset(pos, 0, sizeof(*pos));
+    for (uint8_t sq = 0; sq < 64; sq++) {
+        uint8_t piece = (cp->board[sq / 2] >> ((sq & 1) * 4)) & 0x0F;
+        if (CC_TYPE(piece) == 0) continue;
+        pos->color[CC_COLOR(piece)] |= CC_BB(sq);
+        pos->type[CC_TYPE(piece) - 1] |= CC_BB(sq);
+    }
+    pos->side = cp->side_castling >> 4;
+    pos->castling = cp->side_castling & 0x0F;
+    pos->ep = cp->ep;
+    pos->halfmove = cp->halfmove;
+    pos->fullmove = cp->fullmove;
+    for (uint8_t f = 0; f < 8; f++) {
+        graveyard[f] = (cp->graveyard[f / 2] >> ((f & 1) * 4)) & 0x0F;
+    }
+    *head_x = cp->head_x / 100.0f;
+    *head_y = cp->head_y / 100.0f;
+    memcpy(game_id, cp->game_id, CHECKPOINT_GAME_ID_LEN);
+    game_id[CHECKPOINT_GAME_ID_LEN] = '\0';
+}
+
+// Find the newest valid record and continue the ring after it. Returns false if there is none.
+bool checkpoint_load(checkpoint_t* cp) {
+    checkpoint_t rec;
+    bool found = false;
+    for (uint8_t slot = 0; slot < CHECKPOINT_SLOTS; slot++) {
+        eeprom_read_block(&rec, CHECKPOINT_ADDR(slot), sizeof(rec));
+        if (rec.crc != checkpoint_crc(&rec)) continue;
+        // all records in the ring are within CHECKPOINT_SLOTS saves of each other
+        if (found && (int16_t)(rec.seq - last_seq) <= 0) continue;
+        memcpy(cp, &rec, sizeof(rec));
+        last_seq = rec.seq;
+        next_slot = (uint8_t)((slot + 1) % CHECKPOINT_SLOTS);
+        found = true;
+    }
+    return found;
+}
+
+// Write cp to the next slot. eeprom_update_block() skips unchanged bytes; a changed byte
+// costs ~3.4 ms, so a record after a move takes some tens of ms.
+void checkpoint_save(checkpoint_t* cp) {
+    cp->seq = ++last_seq;
+    cp->crc = checkpoint_crc(cp);
+    eeprom_update_block(cp, CHECKPOINT_ADDR(next_slot), sizeof(*cp));
+    next_slot = (uint8_t)((next_slot + 1) % CHECKPOINT_SLOTS);
+}
@@ -0,0 +1,37 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "chess_core.h"
+
+// Board and gantry state kept in EEPROM so a reset can pick up the game where it was.
+// Records go round a ring of CHECKPOINT_SLOTS slots, each save in the next slot, which
+// spreads the ~100k erase/write cycles per cell over the ring (15 x 64 bytes; the last 64
+// of the ATmega328PB's 1 KB EEPROM hold the axis calibration). The newest record with a
+// good CRC wins on boot.
+#define CHECKPOINT_SLOTS 15
+#define CHECKPOINT_SLOT_SIZE 64
+#define CHECKPOINT_GAME_ID_LEN 8    // Lichess game ids are 8 characters
+
+typedef struct {
+    uint16_t seq;                   // save counter, wraps
+    char game_id[CHECKPOINT_GAME_ID_LEN];   // not terminated, zero padded
+    uint8_t board[32];              // piece code per square, two squares per byte (low nibble first)
+    uint8_t side_castling;          // side to move << 4 | castling rights
+    uint8_t ep;
+    uint8_t halfmove;
+    uint16_t fullmove;
+    uint8_t graveyard[4];           // piece code per graveyard slot, two slots per byte
+    int16_t head_x, head_y;         // hundredths of a square
+    uint8_t crc;                    // CRC-8 of everything above
+} checkpoint_t;
+
+void checkpoint_pack(checkpoint_t* cp, const cc_position_t* pos, const uint8_t graveyard[8],
+                     float head_x, float head_y, const char* game_id);
+void checkpoint_unpack(const checkpoint_t* cp, cc_position_t* pos, uint8_t graveyard[8],
+                       float* head_x, float* head_y, char game_id[CHECKPOINT_GAME_ID_LEN + 1]);
+bool checkpoint_load(checkpoint_t* cp);
+void checkpoint_save(checkpoint_t* cp);
+
+#endif
@@ -0,0 +1,263 @@
+#include "gantry_plan.h"
+#include <math.h>
+#include <string.h>
+
+// The head moves an x leg then a y leg, so travel time is the weighted L1 distance
+float plan_travel_s(float x0, float y0, float x1, float y1) {
+    return fabsf(x1 - x0) * GANTRY_S_PER_SQUARE_X + fabsf(y1 - y0) * GANTRY_S_PER_SQUARE_Y;
+}
+
+// Median of the values counted in hist[0..7]; halfway between the middle two for even totals
+static float hist_median(const uint8_t hist[8], uint8_t total) {
+    uint8_t lo_rank = (uint8_t)((total - 1) / 2), hi_rank = (uint8_t)(total / 2);
+    int8_t lo = -1, hi = -1;
+    uint8_t seen = 0;
+    for (uint8_t v = 0; v < 8; v++) {
+        seen += hist[v];
+        if (lo < 0 && seen > lo_rank) lo = (int8_t)v;
+        if (hi < 0 && seen > hi_rank) hi = (int8_t)v;
+    }
+    return (lo + hi) / 2.0f;
+}
+
+// True if the piece on sq has at least one pseudo-legal move
+static bool can_move(const cc_position_t* pos, uint8_t sq) {
+    cc_move_t mv;
+    char uci[5];
+    cc_square_name(sq, uci);
+    for (uint8_t to = 0; to < 64; to++) {
+        cc_square_name(to, uci + 2);
+        if (cc_parse_uci(pos, uci, &mv) && cc_is_pseudo_legal(pos, &mv)) return true;
+    }
+    return false;
+}
+
+// Where the head should wait while `side` thinks: the per-axis median of that side's
+// pieces that can move. With L1 travel the median minimises the expected distance to the
+// source square when each of those pieces is equally likely to move (a centroid would
+// minimise squared distance). It loses when play stays by home, e.g. one pawn marching up
+// the a-file (game 3 in host/prepos_sim.c); the expected gain does not single such
+// positions out, so there is no skip threshold.
+void plan_prepos_target(const cc_position_t* pos, uint8_t side, float* x, float* y) {
+    uint8_t file_hist[8] = {0}, row_hist[8] = {0};
+    uint8_t total = 0;
+    uint64_t pieces = pos->color[side];
+    for (uint8_t sq = 0; sq < 64; sq++) {
+        if (!(pieces & CC_BB(sq)) || !can_move(pos, sq)) continue;
+        file_hist[CC_FILE(sq)]++;
+        row_hist[7 - CC_RANK(sq)]++;
+        total++;
+    }
+    if (total == 0) {
+        *x = *y = 0.0f;
+        return;
+    }
+    *x = hist_median(file_hist, total);
+    *y = hist_median(row_hist, total);
+}
+
+void plan_head_xy(uint8_t sq, float* x, float* y) {
+    if (sq >= 64) {
+        *x = (float)(sq - 64);
+        *y = -1.0f;
+    } else {
+        *x = HEAD_X(sq);
+        *y = HEAD_Y(sq);
+    }
+}
+
+static float square_travel_s(uint8_t a, uint8_t b) {
+    float ax, ay, bx, by;
+    plan_head_xy(a, &ax, &ay);
+    plan_head_xy(b, &bx, &by);
+    return plan_travel_s(ax, ay, bx, by);
+}
+
+// Square names as move_motor() takes them; graveyard slots are rank 9
+void plan_square_name(uint8_t sq, char out[3]) {
+    if (sq >= 64 && sq < PLAN_SQUARES) {
+        out[0] = (char)('a' + sq - 64);
+        out[1] = '9';
+        out[2] = '\0';
+    } else {
+        cc_square_name(sq, out);
+    }
+}
+
+// ---------- Board reset ----------
+// Empty square outside both starting areas (ranks 3-6) or an empty graveyard slot, nearest
+// to near, that no pending move is headed for
+static uint8_t find_parking(const uint8_t board[PLAN_SQUARES], const plan_move_t* pending, uint8_t n,
+                            uint8_t near) {
+    uint8_t best = CC_NO_SQUARE;
+    float best_s = 0;
+    for (uint8_t sq = 0; sq < PLAN_SQUARES; sq++) {
+        if (board[sq]) continue;
+        if (sq < 64 && (CC_RANK(sq) < 2 || CC_RANK(sq) > 5)) continue;
+        bool taken = false;
+        for (uint8_t i = 0; i < n && !taken; i++) taken = pending[i].to == sq;
+        if (taken) continue;
+        float s = square_travel_s(near, sq);
+        if (best == CC_NO_SQUARE || s < best_s) {
+            best = sq;
+            best_s = s;
+        }
+    }
+    return best;
+}
+
+// Order the pending moves into plan, each one only once its destination is empty.
+// optimise: nearest source to the head first; otherwise in pending (destination square)
+// order. When every remaining move is blocked by another's piece (a cycle), one piece is
+// parked on a free square first.
+static bool order_moves(uint8_t board[PLAN_SQUARES], plan_move_t* pending, uint8_t n, bool optimise,
+                        reset_plan_t* plan) {
+    uint8_t head = CC_SQUARE(0, 7);   // home corner, a8
+    while (n > 0) {
+        int8_t pick = -1;
+        float pick_s = 0;
+        for (uint8_t i = 0; i < n; i++) {
+            if (board[pending[i].to]) continue;
+            float s = square_travel_s(head, pending[i].from);
+            if (pick < 0 || (optimise && s < pick_s)) {
+                pick = (int8_t)i;
+                pick_s = s;
+                if (!optimise) break;
+            }
+        }
+        if (plan->count == PLAN_MAX_MOVES) return false;
+        if (pick < 0) {
+            uint8_t park = find_parking(board, pending, n, pending[0].from);
+            if (park == CC_NO_SQUARE) return false;
+            plan->moves[plan->count].from = pending[0].from;
+            plan->moves[plan->count].to = park;
+            plan->count++;
+            board[park] = board[pending[0].from];
+            board[pending[0].from] = 0;
+            head = park;
+            pending[0].from = park;
+            continue;
+        }
+        plan_move_t mv = pending[pick];
+        plan->moves[plan->count++] = mv;
+        board[mv.to] = board[mv.from];
+        board[mv.from] = 0;
+        head = mv.to;
+        for (uint8_t i = (uint8_t)pick; i + 1 < n; i++) pending[i] = pending[i + 1];
+        n--;
+    }
+    return true;
+}
+
+// Replays the plan on occupancy: every source full and every destination empty when used
+static bool plan_feasible(const reset_plan_t* plan, const uint8_t start[PLAN_SQUARES]) {
+    uint8_t occ[PLAN_SQUARES];
+    memcpy(occ, start, sizeof(occ));
+    for (uint8_t i = 0; i < plan->count; i++) {
+        const plan_move_t* m = &plan->moves[i];
+        if (!occ[m->from] || occ[m->to]) return false;
+        occ[m->to] = occ[m->from];
+        occ[m->from] = 0;
+    }
+    return true;
+}
+
+float plan_reset_cost_s(const reset_plan_t* plan) {
+    uint8_t head = CC_SQUARE(0, 7);
+    float total = 0;
+    for (uint8_t i = 0; i < plan->count; i++) {
+        total += square_travel_s(head, plan->moves[i].from) + square_travel_s(plan->moves[i].from, plan->moves[i].to);
+        head = plan->moves[i].to;
+    }
+    return total;
+}
+
+static void reverse_moves(reset_plan_t* plan, uint8_t i, uint8_t j) {
+    while (i < j) {
+        plan_move_t t = plan->moves[i];
+        plan->moves[i++] = plan->moves[j];
+        plan->moves[j--] = t;
+    }
+}
+
+// 2-opt over the move order: reverse a segment when that shortens the empty travel and
+// every move still finds its source full and its destination free
+static void two_opt(reset_plan_t* plan, const uint8_t start[PLAN_SQUARES]) {
+    float best = plan_reset_cost_s(plan);
+    for (uint8_t pass = 0; pass < 4; pass++) {
+        bool improved = false;
+        for (uint8_t i = 0; i + 1 < plan->count; i++) {
+            for (uint8_t j = (uint8_t)(i + 1); j < plan->count; j++) {
+                reverse_moves(plan, i, j);
+                float cost = plan_reset_cost_s(plan);
+                if (cost + 0.01f < best && plan_feasible(plan, start)) {
+                    best = cost;
+                    improved = true;
+                } else {
+                    reverse_moves(plan, i, j);
+                }
+            }
+        }
+        if (!improved) break;
+    }
+}
+
+// Plan the moves that bring pos (plus the pieces in the graveyard slots) back to the start
+// position. Each start square is filled by the nearest piece of the right kind; start
+// squares with no such piece left are counted in plan->missing. optimise selects nearest
+// neighbour + 2-opt ordering, otherwise moves go square by square (a1, a2, ... h8).
+bool plan_reset(const cc_position_t* pos, const uint8_t graveyard[8], bool optimise, reset_plan_t* plan) {
+    cc_position_t start;
+    uint8_t board[PLAN_SQUARES], initial[PLAN_SQUARES];
+    uint8_t used[PLAN_SQUARES] = {0};
+    plan_move_t pending[PLAN_MAX_MOVES];
+    uint8_t n = 0;
+
+    cc_position_start(&start);
+    for (uint8_t sq = 0; sq < 64; sq++) board[sq] = cc_piece_at(pos, sq);
+    for (uint8_t f = 0; f < 8; f++) board[PLAN_GRAVEYARD(f)] = graveyard[f];
+    memset(plan, 0, sizeof(*plan));
+
+    // pieces already home stay put
+    for (uint8_t sq = 0; sq < 64; sq++) {
+        if (board[sq] && board[sq] == cc_piece_at(&start, sq)) used[sq] = 1;
+    }
+    for (uint8_t t = 0; t < 64; t++) {
+        uint8_t want = cc_piece_at(&start, t);
+        if (!want || used[t]) continue;
+        uint8_t src = CC_NO_SQUARE;
+        float src_s = 0;
+        for (uint8_t sq = 0; sq < PLAN_SQUARES; sq++) {
+            if (used[sq] || board[sq] != want) continue;
+            float s = square_travel_s(sq, t);
+            if (src == CC_NO_SQUARE || s < src_s) {
+                src = sq;
+                src_s = s;
+            }
+        }
+        if (src == CC_NO_SQUARE) {
+            plan->missing++;
+            continue;
+        }
+        used[src] = 1;
+        pending[n].from = src;
+        pending[n].to = t;
+        n++;
+    }
+
+    // leftover pieces (promoted ones) on a start square must make room
+    for (uint8_t sq = 0; sq < 64; sq++) {
+        if (!board[sq] || used[sq] || !cc_piece_at(&start, sq)) continue;
+        uint8_t park = find_parking(board, pending, n, sq);
+        if (park == CC_NO_SQUARE || n == PLAN_MAX_MOVES) return false;
+        pending[n].from = sq;
+        pending[n].to = park;
+        n++;
+        plan->extras++;
+    }
+
+    memcpy(initial, board, sizeof(initial));
+    if (!order_moves(board, pending, n, optimise, plan)) return false;
+    if (optimise) two_opt(plan, initial);
+    return true;
+}
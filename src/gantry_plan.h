@@ -0,0 +1,43 @@
+#ifndef GANTRY_PLAN_H
+#define GANTRY_PLAN_H
+
+#include <stdint.h>
+#include "chess_core.h"
+
+// Gantry planning that needs no hardware: builds for the ATmega and for the host tools in
+// host/. Head coordinates are in squares from the home corner as move_motor() counts them:
+// x = file (a = 0), y = 8 - rank (rank 8 = 0).
+#define HEAD_X(sq) ((float)CC_FILE(sq))
+#define HEAD_Y(sq) ((float)(7 - CC_RANK(sq)))
+
+// Seconds per square of travel, from the step timers (200 steps/s) and the x/y turn ratios
+#define GANTRY_S_PER_SQUARE_X 0.9f
+#define GANTRY_S_PER_SQUARE_Y 0.925f
+
+// Pause after each leg of move_piece() before the next one starts
+#define GANTRY_SETTLE_MS 10000
+
+// Captured pieces wait in a graveyard slot beside their file, rank 9 (head y = -1)
+#define PLAN_GRAVEYARD(file) ((uint8_t)(64 + (file)))
+#define PLAN_SQUARES 72
+#define PLAN_MAX_MOVES 48
+
+typedef struct {
+    uint8_t from, to;       // squares 0..63, or PLAN_GRAVEYARD() slots
+} plan_move_t;
+
+typedef struct {
+    uint8_t count;
+    plan_move_t moves[PLAN_MAX_MOVES];
+    uint8_t missing;        // start squares no piece could be found for
+    uint8_t extras;         // pieces with no start square (promotions), parked off the back ranks
+} reset_plan_t;
+
+float plan_travel_s(float x0, float y0, float x1, float y1);
+void plan_head_xy(uint8_t sq, float* x, float* y);
+void plan_prepos_target(const cc_position_t* pos, uint8_t side, float* x, float* y);
+bool plan_reset(const cc_position_t* pos, const uint8_t graveyard[8], bool optimise, reset_plan_t* plan);
+float plan_reset_cost_s(const reset_plan_t* plan);
+void plan_square_name(uint8_t sq, char out[3]);
+
+#endif
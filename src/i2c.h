@@ -1,6 +1,7 @@
 #ifndef I2C_H
 #define I2C_H
 
+#include <stdbool.h>
 #include <stdint.h>
 // TWI Status Codes (relevant ones)
 #define TWI_WRITE           0x00
@@ -34,6 +35,16 @@ typedef enum {
 
 #define MCP23008_GPIO_REG  0x09  // GPIO register address for reading data
 
+// MCP23017, IOCON.BANK = 0 (power-on default): A and B registers interleaved, so a
+// sequential read from GPIOA returns GPIOB next
+#define MCP23017_IODIRA_REG 0x00
+#define MCP23017_IODIRB_REG 0x01
+#define MCP23017_IPOLA_REG  0x02
+#define MCP23017_IPOLB_REG  0x03
+#define MCP23017_GPPUA_REG  0x0C
+#define MCP23017_GPPUB_REG  0x0D
+#define MCP23017_GPIOA_REG  0x12
+
 void TWI_init(void);
 twi_error_t TWI_start(void);
 void TWI_stop(void);
@@ -42,6 +53,10 @@ twi_error_t TWI_write_addr(uint8_t address, uint8_t rw_bit);
 uint8_t twi_read_byte(uint8_t send_ack);
 twi_error_t mcp_write_register(uint8_t addr_offset, uint8_t reg, uint8_t data);
 uint8_t mcp_read_register(uint8_t addr_offset, uint8_t reg, twi_error_t* error_code);
+twi_error_t mcp_read_registers(uint8_t addr_offset, uint8_t reg, uint8_t* data, uint8_t count);
 twi_error_t initialize_mcp23008_inputs(uint8_t device_id);
+bool mcp23008_inputs_configured(uint8_t device_id);
+twi_error_t initialize_mcp23017_inputs(uint8_t device_id);
+bool mcp23017_inputs_configured(uint8_t device_id);
 
 #endif
@@ -0,0 +1,100 @@
+#include "idle.h"
+#include "profile.h"
+#include "stepgen.h"
+#include "trace.h"
+#include "uart_esp.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    uint32_t window_start_us;   // trace_now_us() at the last report
+    uint32_t asleep_us;
+    uint32_t longest_us;
+    uint16_t sleeps;
+    uint16_t scans;             // scans right after a wake
+    uint32_t latency_sum_us;
+    uint32_t latency_max_us;
+} idle_stats_t;
+
+static idle_stats_t stats;
+static bool woke;               // the last idle_wait() slept
+
+// Clocks of the peripherals nothing uses: Timer2, both SPIs, the second TWI, the ADC,
+// the touch controller and the analog comparator
+void idle_init(void) {
+    PRR0 |= (1 << PRTIM2) | (1 << PRSPI0) | (1 << PRADC);
+    PRR1 |= (1 << PRSPI1) | (1 << PRPTC) | (1 << PRTWI1);
+    ACSR |= (1 << ACD);
+    memset(&stats, 0, sizeof(stats));
+    stats.window_start_us = trace_now_us();
+}
+
+// Called with work_pending read under cli(), so an interrupt between the check and the
+// sleep can't be lost: sei takes effect after the next instruction, which is the sleep,
+// and the interrupt then wakes it at once. Returns with interrupts on.
+void idle_wait(bool work_pending) {
+    woke = false;
+#if IDLE_SLEEP
+    if (work_pending) {
+        sei();
+        return;
+    }
+    // regions in the step ISR need the profiling clock; without a move nothing does
+    bool hold_clock = !stepgen_busy();
+    if (hold_clock) profile_clock_hold();
+    uint32_t t0 = trace_now_us();
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+    // the interrupt that woke us has run by now
+    uint32_t dt = trace_now_us() - t0;
+    if (hold_clock) profile_clock_release();
+    stats.asleep_us += dt;
+    if (dt > stats.longest_us) stats.longest_us = dt;
+    stats.sleeps++;
+    woke = true;
+#else
+    (void)work_pending;
+    sei();
+#endif
+}
+
+// Just before the main loop's scan_board(): Timer4 restarted from 0 at the compare match
+// that asked for the scan, so TCNT4 is the time since that match. After a wake on an ESP
+// line it includes the command run before the scan, up to a whole scan period (a command
+// longer than that has the timer wrap, and the scan counts from the latest match).
+void idle_scan_started(void) {
+    uint32_t us = TCNT4 * TRACE_US_PER_TICK;
+#if IDLE_SLEEP
+    if (!woke) return;
+#endif
+    woke = false;
+    stats.scans++;
+    stats.latency_sum_us += us;
+    if (us > stats.latency_max_us) stats.latency_max_us = us;
+}
+
+// "pf:idle asleep=<permille> sleeps=<n> longest=<us> wake2scan n=<n> mean=<us> max=<us> window=<ms>"
+// and a new window
+void idle_report(void) {
+    char buf[112];
+    uint32_t now = trace_now_us();
+    uint32_t window_us = now - stats.window_start_us;
+    uint32_t permille = window_us ? (uint32_t)((uint64_t)stats.asleep_us * 1000 / window_us) : 0;
+    snprintf_P(buf, sizeof(buf), PSTR("pf:idle asleep=%lu.%lu%% sleeps=%u longest=%lu wake2scan n=%u mean=%lu max=%lu window=%lu"),
+               (unsigned long)(permille / 10), (unsigned long)(permille % 10), stats.sleeps,
+               (unsigned long)stats.longest_us, stats.scans,
+               stats.scans ? (unsigned long)(stats.latency_sum_us / stats.scans) : 0UL, (unsigned long)stats.latency_max_us,
+               (unsigned long)(window_us / 1000));
+    printf_P(PSTR("%s\n"), buf + 3);
+    uart1_send_string(buf);
+    uart1_send_byte('\n');
+    memset(&stats, 0, sizeof(stats));
+    stats.window_start_us = now;
+}
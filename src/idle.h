@@ -0,0 +1,27 @@
+#ifndef IDLE_H
+#define IDLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Sleep between main loop passes. With nothing to do the CPU waits in idle mode for the
+// next interrupt: the Timer4 scan tick, a byte from the ESP (USART1), the step generator
+// finishing a leg, or a limit switch. Power-save would stop Timer4 and the USART clocks
+// with it, so idle is as deep as the scan tick allows. Nothing ticks in between: Timer1
+// only interrupts while a move runs, Timer3 while the magnet is on, and the profiling
+// clock's overflow interrupt is held off while asleep.
+//
+// "prof" adds "pf:idle" with the share of time spent asleep since the last report, the
+// number of sleeps, the longest one, and the wake-to-scan latency (Timer4 compare match
+// to scan_board() after a sleep). Build with -DIDLE_SLEEP=0 to keep the busy loop; the
+// latency is measured either way.
+#ifndef IDLE_SLEEP
+#define IDLE_SLEEP 1
+#endif
+
+void idle_init(void);
+void idle_wait(bool work_pending);
+void idle_scan_started(void);
+void idle_report(void);
+
+#endif
@@ -0,0 +1,67 @@
+#include "magnet.h"
+#include "profile.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+#define MAGNET_PRESCALE 8UL
+#define MAGNET_PERIOD_TICKS (F_CPU / MAGNET_PRESCALE / MAGNET_PWM_HZ)
+#define MAGNET_HOLD_TICKS (MAGNET_PERIOD_TICKS * MAGNET_HOLD_PERCENT / 100)
+#define MAGNET_BOOST_PERIODS (MAGNET_BOOST_MS * MAGNET_PWM_HZ / 1000)
+
+static volatile uint16_t boost_left;    // full power PWM periods still to go
+static volatile uint8_t magnet_state;
+
+void magnet_init(void) {
+    DDRD |= (1 << PD1);
+    PORTD &= ~(1 << PD1);
+    TCCR3A = 0;                         // OC3A/OC3B disconnected: PD0 is a step pin
+    TCCR3B = (1 << WGM32);              // CTC on OCR3A, clock stopped until magnet_on()
+    OCR3A = MAGNET_PERIOD_TICKS - 1;
+    OCR3B = MAGNET_HOLD_TICKS;
+}
+
+void magnet_on(void) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        boost_left = MAGNET_BOOST_PERIODS;
+        magnet_state = 1;
+        PORTD |= (1 << PD1);
+        TCNT3 = 0;
+        TIFR3 = (1 << OCF3A) | (1 << OCF3B);
+        TIMSK3 = (1 << OCIE3A);         // duty compare only once the boost is over
+        TCCR3B = (1 << WGM32) | (1 << CS31);
+    }
+}
+
+void magnet_off(void) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        TCCR3B = (1 << WGM32);
+        TIMSK3 = 0;
+        PORTD &= ~(1 << PD1);
+        magnet_state = 0;
+    }
+}
+
+bool magnet_is_on(void) {
+    return magnet_state;
+}
+
+// Start of a PWM period
+ISR(TIMER3_COMPA_vect) {
+    PROFILE_BEGIN(t_isr);
+    if (!boost_left) {
+        PORTD |= (1 << PD1);
+    } else if (--boost_left == 0) {
+        TIFR3 = (1 << OCF3B);
+        TIMSK3 |= (1 << OCIE3B);
+    }
+    PROFILE_END(PROF_MAGNET_ISR, t_isr);
+}
+
+// End of the on time while holding
+ISR(TIMER3_COMPB_vect) {
+    PORTD &= ~(1 << PD1);
+}
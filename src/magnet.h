@@ -0,0 +1,28 @@
+#ifndef MAGNET_H
+#define MAGNET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Electromagnet on PD1, driven with PWM. PD1 is OC4A, but Timer4 keeps the scan tick, so
+// the PWM is made in software from Timer3 (CTC, the pin itself not connected to the
+// timer): the period compare raises PD1 and the duty compare drops it again.
+//
+// magnet_on() starts with MAGNET_BOOST_MS at full power to pull the piece in across the
+// air gap, then the Timer3 ISR drops to MAGNET_HOLD_PERCENT on its own, which is enough
+// to drag a piece that is already against the board and keeps the coil cooler.
+// magnet_off() drops the duty to zero at once. The driver is a single low-side switch, so
+// the field can't be reversed: the release time depends on the flyback path, and
+// MAGNET_RELEASE_MS covers it.
+#define MAGNET_PWM_HZ 1000UL
+#define MAGNET_BOOST_MS 150
+#define MAGNET_HOLD_PERCENT 60
+#define MAGNET_PULLIN_MS 80         // wait after magnet_on() before moving off
+#define MAGNET_RELEASE_MS 30        // wait after magnet_off() before moving away
+
+void magnet_init(void);
+void magnet_on(void);
+void magnet_off(void);
+bool magnet_is_on(void);
+
+#endif
@@ -0,0 +1,111 @@
+#include "move_detect.h"
+#include <string.h>
+
+// Idle on the given board
+void move_detect_reset(move_detector_t* d, const uint8_t columns[8]) {
+    d->state = STATE_IDLE;
+    d->start_row = d->start_col = -1;
+    d->end_row = d->end_col = -1;
+    d->captured_row = d->captured_col = -1;
+    memcpy(d->base, columns, sizeof(d->base));
+    memcpy(d->current, columns, sizeof(d->current));
+}
+
+// The rook half of a castle whose king move was already sent: the position has it already
+static bool is_castling_rook_move(const move_detector_t* d, const cc_move_t* last_move) {
+    return (last_move->flags & CC_MOVE_CASTLE) &&
+           last_move->rook_from == CC_SQUARE(d->start_col, d->start_row) &&
+           last_move->rook_to == CC_SQUARE(d->end_col, d->end_row);
+}
+
+// One scan: columns as read (byte = file, bit = rank), failed = files that couldn't be
+// read (kept as they were), mask = squares the gantry disturbs, read as in base.
+// Returns what the scan completed; the squares involved are in d.
+detect_result_t move_detect_scan(move_detector_t* d, const uint8_t columns[8], uint8_t failed,
+                                 const uint8_t mask[8], const cc_move_t* last_move) {
+    int8_t current_scan_removed_count = 0;
+    int8_t current_scan_added_count = 0;
+    int8_t observed_removed_row = -1, observed_removed_col = -1;
+    int8_t observed_added_row = -1, observed_added_col = -1;
+    detect_result_t result = DETECT_NONE;
+
+    for (uint8_t col = 0; col < 8; col++) {
+        if ((failed >> col) & 1) continue;
+        // squares the gantry is dragging a piece across read as they were before the move
+        uint8_t data = (columns[col] & ~mask[col]) | (d->base[col] & mask[col]);
+        uint8_t diff = data ^ d->base[col];
+        if (diff > 0) {
+            for (uint8_t row = 0; row < 8; row++) {
+                if ((diff >> row) & 1) {
+                    if ((d->base[col] >> row) & 1) {
+                        current_scan_removed_count++;
+                        observed_removed_row = row;
+                        observed_removed_col = col;
+                    } else {
+                        current_scan_added_count++;
+                        observed_added_row = row;
+                        observed_added_col = col;
+                    }
+                }
+            }
+        }
+        d->current[col] = data;
+    }
+
+    switch (d->state) {
+        case STATE_IDLE:
+            // Look for exactly one piece being lifted from the base state
+            if (current_scan_removed_count == 1 && current_scan_added_count == 0) {
+                d->start_row = observed_removed_row;
+                d->start_col = observed_removed_col;
+                d->state = STATE_PIECE_LIFTED;
+                result = DETECT_LIFTED;
+            } else if (current_scan_added_count > 0) {
+                memcpy(d->base, d->current, sizeof(d->base));
+                result = DETECT_ADDED;
+            }
+            break;
+        case STATE_PIECE_LIFTED:
+            if (current_scan_added_count == 1 && current_scan_removed_count == 1) {
+                // A single piece was placed back down (standard move completion)
+                d->end_row = observed_added_row;
+                d->end_col = observed_added_col;
+                if (is_castling_rook_move(d, last_move)) {
+                    result = DETECT_ROOK;
+                } else if (d->start_row != d->end_row || d->start_col != d->end_col) {
+                    result = DETECT_MOVE;
+                } else {
+                    result = DETECT_RETURNED;
+                }
+                d->state = STATE_IDLE;
+                memcpy(d->base, d->current, sizeof(d->base));
+            } else if (current_scan_removed_count == 2 && current_scan_added_count == 0) {
+                // A second piece was lifted before the first was placed (a capture scenario start)
+                d->captured_row = observed_removed_row;
+                d->captured_col = observed_removed_col;
+                d->state = STATE_PIECE_CAPTURED;
+                memcpy(d->base, d->current, sizeof(d->base));
+                result = DETECT_SECOND_LIFT;
+            } else if (current_scan_added_count > 1 || current_scan_removed_count > 2) {
+                // Multiple ambiguous changes, reset state machine for safety.
+                // Force a resync of the base state to the current physical state, abandoning partial moves.
+                d->state = STATE_IDLE;
+                memcpy(d->base, d->current, sizeof(d->base));
+                result = DETECT_AMBIGUOUS;
+            }
+            break;
+        case STATE_PIECE_CAPTURED:
+            // We are waiting ONLY for a single piece to be placed back down
+            if (current_scan_added_count == 1 && current_scan_removed_count == 0) {
+                // The move is finished
+                d->end_row = observed_added_row;
+                d->end_col = observed_added_col;
+                d->state = STATE_IDLE;
+                // Sync the base state to the new board layout
+                memcpy(d->base, d->current, sizeof(d->base));
+                result = DETECT_CAPTURE;
+            }
+            break;
+    }
+    return result;
+}
@@ -0,0 +1,42 @@
+#ifndef MOVE_DETECT_H
+#define MOVE_DETECT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "chess_core.h"
+
+// Move detection from the reed switch scans: a state machine over the squares that
+// changed against the board as it stood after the last validated move. No hardware
+// access, so host/sensor_replay.c runs the same code on recorded scans.
+typedef enum {
+    STATE_IDLE,                 // Waiting for the first piece to be lifted
+    STATE_PIECE_LIFTED,         // One piece has been lifted
+    STATE_PIECE_CAPTURED,       // A second piece was lifted (capture scenario)
+} GameState_t;
+
+typedef enum {
+    DETECT_NONE,
+    DETECT_LIFTED,              // first piece up, from start
+    DETECT_ADDED,               // pieces appeared while idle: taken as the new base
+    DETECT_ROOK,                // the rook half of the castle in last_move
+    DETECT_MOVE,                // start -> end
+    DETECT_RETURNED,            // piece put back where it came from
+    DETECT_SECOND_LIFT,         // capture started, second piece up from captured
+    DETECT_AMBIGUOUS,           // too many changes: back to idle on the current board
+    DETECT_CAPTURE,             // start -> end, taking on captured
+} detect_result_t;
+
+typedef struct {
+    GameState_t state;
+    int8_t start_row, start_col;
+    int8_t end_row, end_col;
+    int8_t captured_row, captured_col;
+    uint8_t base[8];            // The state after the last *validated* move
+    uint8_t current[8];         // Last scan, squares under the moving gantry as in base
+} move_detector_t;
+
+void move_detect_reset(move_detector_t* d, const uint8_t columns[8]);
+detect_result_t move_detect_scan(move_detector_t* d, const uint8_t columns[8], uint8_t failed,
+                                 const uint8_t mask[8], const cc_move_t* last_move);
+
+#endif
@@ -0,0 +1,86 @@
+#include "placement.h"
+#include "sensors.h"
+#include "steppermotor.h"
+#include <avr/pgmspace.h>
+#include <stdio.h>
+
+placement_stats_t placement_stats;
+static uint8_t moves_since_home = 0;
+
+typedef enum {
+    PLACE_OK,
+    PLACE_NOT_ARRIVED,      // source empty but the target doesn't see the piece
+    PLACE_NOT_LEFT,         // piece still on its source square
+    PLACE_READ_ERROR,
+} place_result_t;
+
+// Sensor for a square in move notation; false for the graveyard row, which has none
+static bool square_sensor(const char* sq, uint8_t* file, uint8_t* rank) {
+    *file = (uint8_t)(sq[0] - 'a');
+    *rank = (uint8_t)(sq[1] - '1');
+    return *file < 8 && *rank < 8;
+}
+
+// Read the source and target columns: only the expanders the move touched
+static place_result_t check_placement(const char* cmd) {
+    uint8_t from_file, from_rank, to_file, to_rank;
+    uint8_t files = 0;
+    uint8_t columns[8];
+    bool from = square_sensor(cmd, &from_file, &from_rank);
+    bool to = square_sensor(cmd + 2, &to_file, &to_rank);
+    if (from) files |= (uint8_t)(1 << from_file);
+    if (to) files |= (uint8_t)(1 << to_file);
+    if (sensors_read(files, columns)) return PLACE_READ_ERROR;
+    if (from && ((columns[from_file] >> from_rank) & 1)) return PLACE_NOT_LEFT;
+    if (to && !((columns[to_file] >> to_rank) & 1)) return PLACE_NOT_ARRIVED;
+    return PLACE_OK;
+}
+
+// move_motor() with verification: carry the piece, check, nudge or repeat, then re-home.
+// Returns false if the piece still isn't where it should be; the move is not undone.
+bool place_piece(const char* cmd) {
+    place_result_t result;
+    uint8_t retries = 0;
+
+    placement_stats.moves++;
+    move_piece(cmd);
+    while ((result = check_placement(cmd)) != PLACE_OK && result != PLACE_READ_ERROR &&
+           retries < PLACE_MAX_RETRIES) {
+        retries++;
+        if (result == PLACE_NOT_ARRIVED) {
+            printf_P(PSTR("VERIFY: %.4s not seen on %c%c, nudging (%u)\n"), cmd, cmd[2], cmd[3], retries);
+            placement_stats.nudges++;
+            nudge_piece();
+        } else {
+            printf_P(PSTR("VERIFY: %.4s still on %c%c, repeating (%u)\n"), cmd, cmd[0], cmd[1], retries);
+            placement_stats.repeats++;
+            move_piece(cmd);
+        }
+    }
+    if (result != PLACE_OK || !motion_is_calibrated() || ++moves_since_home >= PLACE_REHOME_EVERY) {
+        init_pos();
+        moves_since_home = 0;
+    }
+
+    if (result == PLACE_READ_ERROR) {
+        // can't tell either way; counted as neither success nor failure
+        printf_P(PSTR("VERIFY: %.4s sensor read failed\n"), cmd);
+        return true;
+    }
+    if (result != PLACE_OK) {
+        placement_stats.failed++;
+        printf_P(PSTR("VERIFY: %.4s FAILED, place the piece on %c%c by hand\n"), cmd, cmd[2], cmd[3]);
+    } else if (retries) {
+        placement_stats.retried++;
+    } else {
+        placement_stats.first_try++;
+    }
+    placement_print_stats();
+    return result == PLACE_OK;
+}
+
+void placement_print_stats(void) {
+    const placement_stats_t* st = &placement_stats;
+    printf_P(PSTR("VERIFY: %u moves, %u first try, %u retried, %u failed (%u nudges, %u repeats)\n"),
+             st->moves, st->first_try, st->retried, st->failed, st->nudges, st->repeats);
+}
@@ -0,0 +1,28 @@
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Closed-loop gantry moves: after each piece is set down the source and target columns
+// are read back from their MCP23008s. A piece that didn't arrive gets a local nudge, or
+// the move is repeated if it never left, before the head re-homes. With calibrated axes
+// the head re-homes only every PLACE_REHOME_EVERY moves, and after any failure.
+#define PLACE_MAX_RETRIES 2
+#define PLACE_REHOME_EVERY 8
+
+typedef struct {
+    uint16_t moves;
+    uint16_t first_try;     // verified without a retry
+    uint16_t retried;       // verified after one or more retries
+    uint16_t failed;        // still wrong after PLACE_MAX_RETRIES
+    uint16_t nudges;
+    uint16_t repeats;       // whole move repeated, the piece hadn't left its square
+} placement_stats_t;
+
+extern placement_stats_t placement_stats;
+
+bool place_piece(const char* cmd);
+void placement_print_stats(void);
+
+#endif
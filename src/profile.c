@@ -0,0 +1,101 @@
+#include "profile.h"
+#include "uart_esp.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <util/atomic.h>
+#include <stdio.h>
+#include <string.h>
+
+#if PROFILE
+
+typedef struct {
+    uint32_t min, max;          // ticks
+    uint32_t sum;
+    uint16_t count;
+    uint16_t bins[PROFILE_BINS];
+} profile_stats_t;
+
+static const char region_names[PROF_REGIONS][8] PROGMEM = {
+    "scan", "print", "twi", "stepisr", "magisr",
+};
+
+static profile_stats_t stats[PROF_REGIONS];
+static volatile uint32_t overflows;
+
+void profile_init(void) {
+    memset(stats, 0, sizeof(stats));
+    for (uint8_t i = 0; i < PROF_REGIONS; i++) stats[i].min = UINT32_MAX;
+    TCCR0A = 0;
+    TCCR0B = (1 << CS01) | (1 << CS00);     // normal mode, F_CPU/64
+    TIMSK0 |= (1 << TOIE0);
+}
+
+ISR(TIMER0_OVF_vect) {
+    overflows++;
+}
+
+// Keep the overflow interrupt from waking a sleeping main loop every 1.024 ms
+// (src/idle.c). Only while no region can be open: profile_now() misses the overflows in
+// between, so it measures durations, not time of day.
+void profile_clock_hold(void) {
+    TIMSK0 &= ~(1 << TOIE0);
+}
+
+void profile_clock_release(void) {
+    TIMSK0 |= (1 << TOIE0);
+}
+
+// Ticks since profile_init(); also works inside an ISR
+uint32_t profile_now(void) {
+    uint32_t ovf;
+    uint8_t t;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ovf = overflows;
+        t = TCNT0;
+        // wrapped, but the overflow ISR hasn't run yet (interrupts are off)
+        if ((TIFR0 & (1 << TOV0)) && t < 128) ovf++;
+    }
+    return (ovf << 8) | t;
+}
+
+// Regions are recorded either from the main loop or from one ISR, never both, so only
+// the report needs to lock out the ISRs
+void profile_record(profile_region_t region, uint32_t ticks) {
+    profile_stats_t* st = &stats[region];
+    uint32_t us = ticks * PROFILE_US_PER_TICK;
+    uint8_t bin = 0;
+    for (uint32_t limit = 16; us >= limit && bin < PROFILE_BINS - 1; limit <<= 2) bin++;
+
+    if (ticks < st->min) st->min = ticks;
+    if (ticks > st->max) st->max = ticks;
+    if (st->count == UINT16_MAX) return;    // keep the mean consistent with the count
+    st->sum += ticks;
+    st->count++;
+    st->bins[bin]++;
+}
+
+// One line per region: "pf:<name> n=<count> min=<us> mean=<us> max=<us> h=<bins>"
+void profile_report(void) {
+    char buf[96];
+    for (uint8_t i = 0; i < PROF_REGIONS; i++) {
+        profile_stats_t st;
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            st = stats[i];
+        }
+        if (!st.count) continue;
+        char name[sizeof(region_names[0])];
+        strcpy_P(name, region_names[i]);
+        int n = snprintf_P(buf, sizeof(buf), PSTR("pf:%s n=%u min=%lu mean=%lu max=%lu h="), name, st.count,
+                           st.min * PROFILE_US_PER_TICK, st.sum / st.count * PROFILE_US_PER_TICK,
+                           st.max * PROFILE_US_PER_TICK);
+        for (uint8_t b = 0; b < PROFILE_BINS && n < (int)sizeof(buf) - 8; b++) {
+            n += snprintf_P(buf + n, sizeof(buf) - n, b ? PSTR(",%u") : PSTR("%u"), st.bins[b]);
+        }
+        printf_P(PSTR("%s\n"), buf);
+        uart1_send_string(buf);
+        uart1_send_byte('\n');
+    }
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+
+// Region profiling. Timer0 runs free at F_CPU/64 (4 us per tick, overflow ISR every
+// 1.024 ms) and PROFILE_BEGIN/PROFILE_END time a region against it. Each region keeps
+// min, max and mean plus a histogram of powers of four: < 16 us, < 64 us, ... >= 64 ms.
+// "prof" from the ESP prints the table on the debug UART and sends it to the ESP as
+// "pf:" lines. Build with -DPROFILE=0 to leave all of it out, Timer0 included.
+#ifndef PROFILE
+#define PROFILE 1
+#endif
+
+#define PROFILE_US_PER_TICK 4UL
+#define PROFILE_BINS 8
+
+typedef enum {
+    PROF_SCAN,              // scan_board(): sensor read and move detection
+    PROF_PRINT_MATRIX,      // print_gpio_matrix()
+    PROF_TWI_READ,          // one expander read in sensors_read()
+    PROF_STEP_ISR,          // Timer1 step generator
+    PROF_MAGNET_ISR,        // Timer3 magnet PWM, period compare
+    PROF_REGIONS,
+} profile_region_t;
+
+#if PROFILE
+#define PROFILE_BEGIN(var) uint32_t var = profile_now()
+#define PROFILE_END(region, var) profile_record((region), profile_now() - (var))
+
+void profile_init(void);
+uint32_t profile_now(void);
+void profile_record(profile_region_t region, uint32_t ticks);
+void profile_report(void);
+void profile_clock_hold(void);
+void profile_clock_release(void);
+#else
+#define PROFILE_BEGIN(var)
+#define PROFILE_END(region, var)
+#define profile_init() ((void)0)
+#define profile_report() ((void)0)
+#define profile_clock_hold() ((void)0)
+#define profile_clock_release() ((void)0)
+#endif
+
+#endif
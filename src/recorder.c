@@ -0,0 +1,130 @@
+#include "recorder.h"
+#include "trace.h"
+#include "uart_esp.h"
+#include <avr/pgmspace.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#if RECORDER
+
+typedef struct {
+    uint32_t ms;
+    uint8_t kind;
+    uint8_t a, b;
+} rec_event_t;
+
+static rec_event_t ring[RECORDER_EVENTS];
+static uint8_t ring_next = 0;           // slot the next event goes in
+static uint8_t ring_count = 0;
+
+// Where the oldest event in the ring starts from. Exact until the ring wraps; after that
+// only the raw columns and masks are kept up to date, and the replay starts idle on them.
+static move_detector_t snap;
+static uint8_t snap_raw[8], snap_mask[8];
+static bool snap_exact;
+
+// Raw columns and masks as last recorded, to leave out what didn't change
+static uint8_t last_raw[8], last_mask[8];
+
+void recorder_event(rec_kind_t kind, uint8_t a, uint8_t b) {
+    rec_event_t* ev = &ring[ring_next];
+    if (ring_count == RECORDER_EVENTS) {
+        // overwriting the oldest: fold it into the start
+        if (ev->kind == REC_COLUMN) snap_raw[ev->a] = ev->b;
+        else if (ev->kind == REC_MASK) snap_mask[ev->a] = ev->b;
+        snap_exact = false;
+    } else {
+        ring_count++;
+    }
+    ev->ms = trace_now_us() / 1000;
+    ev->kind = (uint8_t)kind;
+    ev->a = a;
+    ev->b = b;
+    ring_next = (uint8_t)((ring_next + 1) % RECORDER_EVENTS);
+}
+
+void recorder_clear(const move_detector_t* d, const uint8_t columns[8], const uint8_t mask[8]) {
+    ring_next = ring_count = 0;
+    snap = *d;
+    memcpy(snap_raw, columns, sizeof(snap_raw));
+    memcpy(snap_mask, mask, sizeof(snap_mask));
+    memcpy(last_raw, columns, sizeof(last_raw));
+    memcpy(last_mask, mask, sizeof(last_mask));
+    snap_exact = true;
+}
+
+// Before the detector sees the scan
+void recorder_scan(const uint8_t columns[8], uint8_t failed, const uint8_t mask[8]) {
+    for (uint8_t file = 0; file < 8; file++) {
+        if (mask[file] != last_mask[file]) {
+            recorder_event(REC_MASK, file, mask[file]);
+            last_mask[file] = mask[file];
+        }
+    }
+    for (uint8_t file = 0; file < 8; file++) {
+        if ((failed >> file) & 1) {
+            recorder_event(REC_FAILED, file, 0);
+        } else if (columns[file] != last_raw[file]) {
+            recorder_event(REC_COLUMN, file, columns[file]);
+            last_raw[file] = columns[file];
+        }
+    }
+}
+
+void recorder_result(detect_result_t result, const move_detector_t* d) {
+    if (result == DETECT_NONE) return;
+    recorder_event(REC_DETECT, (uint8_t)result, (uint8_t)d->state);
+    if (result == DETECT_MOVE || result == DETECT_CAPTURE) {
+        recorder_event(REC_MOVE, CC_SQUARE(d->start_col, d->start_row), CC_SQUARE(d->end_col, d->end_row));
+    }
+    if (result == DETECT_CAPTURE) {
+        recorder_event(REC_CAPTURE, CC_SQUARE(d->captured_col, d->captured_row), 0);
+    }
+}
+
+static void send_line(const char* line) {
+    printf_P(PSTR("%s\n"), line);
+    uart1_send_string(line);
+    uart1_send_byte('\n');
+}
+
+static void send_line_P(const char* line) {
+    puts_P(line);
+    uart1_send_string_P(line);
+    uart1_send_byte('\n');
+}
+
+static void hex8(char* out, const uint8_t bytes[8]) {
+    for (uint8_t i = 0; i < 8; i++) sprintf_P(out + 2 * i, PSTR("%02x"), bytes[i]);
+}
+
+// rc:begin <events> <exact>
+// rc:snap <state> <start r c> <end r c> <captured r c> <base> <current> <raw> <mask>
+// rc:<ms> <kind> <a> <b>          oldest first
+// rc:end
+void recorder_dump(void) {
+    char buf[112];
+    snprintf_P(buf, sizeof(buf), PSTR("rc:begin %u %u"), ring_count, snap_exact);
+    send_line(buf);
+    int n = snprintf_P(buf, sizeof(buf), PSTR("rc:snap %u %d %d %d %d %d %d "), snap.state, snap.start_row, snap.start_col,
+                       snap.end_row, snap.end_col, snap.captured_row, snap.captured_col);
+    hex8(buf + n, snap.base);
+    buf[n + 16] = ' ';
+    hex8(buf + n + 17, snap.current);
+    buf[n + 33] = ' ';
+    hex8(buf + n + 34, snap_raw);
+    buf[n + 50] = ' ';
+    hex8(buf + n + 51, snap_mask);
+    send_line(buf);
+    uint8_t i = (uint8_t)((ring_next + RECORDER_EVENTS - ring_count) % RECORDER_EVENTS);
+    for (uint8_t k = 0; k < ring_count; k++) {
+        const rec_event_t* ev = &ring[i];
+        snprintf_P(buf, sizeof(buf), PSTR("rc:%lu %c %u %u"), (unsigned long)ev->ms, ev->kind, ev->a, ev->b);
+        send_line(buf);
+        i = (uint8_t)((i + 1) % RECORDER_EVENTS);
+    }
+    send_line_P(PSTR("rc:end"));
+}
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include <stdint.h>
+#include "move_detect.h"
+
+// Sensor event recorder. A ring of the last RECORDER_EVENTS events: raw column bytes that
+// changed since the scan before, motion masks, bases rewritten after gantry moves, the
+// detector's results and the moves it emitted, each with a millisecond timestamp.
+// Scans that read the same as the one before are left out; they can't change what the
+// detector does. "rec" from the ESP dumps the ring as "rc:" lines, which
+// host/sensor_replay.c feeds through src/move_detect.c again; "rec clear" starts over.
+// Build with -DRECORDER=0 to leave it out.
+#ifndef RECORDER
+#define RECORDER 1
+#endif
+
+#define RECORDER_EVENTS 32
+
+typedef enum {
+    REC_COLUMN = 'C',       // a = file, b = raw column byte
+    REC_FAILED = 'F',       // a = file that couldn't be read
+    REC_MASK = 'M',         // a = file, b = motion mask
+    REC_BASE = 'B',         // a = file, b = base and current rewritten after motion
+    REC_CASTLE = 'K',       // a = rook from, b = rook to of last_move's castle, 64 if none
+    REC_DETECT = 'D',       // a = detect_result_t, b = state after it
+    REC_MOVE = 'V',         // a = from square, b = to square
+    REC_CAPTURE = 'X',      // a = captured square, after its 'V'
+} rec_kind_t;
+
+#if RECORDER
+void recorder_clear(const move_detector_t* d, const uint8_t columns[8], const uint8_t mask[8]);
+void recorder_scan(const uint8_t columns[8], uint8_t failed, const uint8_t mask[8]);
+void recorder_result(detect_result_t result, const move_detector_t* d);
+void recorder_event(rec_kind_t kind, uint8_t a, uint8_t b);
+void recorder_dump(void);
+#else
+#define recorder_clear(d, columns, mask) ((void)0)
+#define recorder_scan(columns, failed, mask) ((void)0)
+#define recorder_result(result, d) ((void)0)
+#define recorder_event(kind, a, b) ((void)0)
+#define recorder_dump() ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef SENSOR_MAP_H
+#define SENSOR_MAP_H
+
+// Expander pin to square wiring, included by sensors.c only. One row per expander, by I2C
+// address offset from 0x20; one entry per pin, GP0..GP7 (GPA0..GPA7 then GPB0..GPB7 on an
+// MCP23017). An entry is SENSOR_SQ(file, rank), files and ranks counted from 0, or
+// SENSOR_NC for a pin with no switch.
+#define SENSOR_SQ(file, rank) ((uint8_t)((file) << 3 | (rank)))
+#define SENSOR_NC 0xFF
+
+// Rank 1 on pin 0 up to rank 8 on pin 7
+#define SENSOR_FILE(file) \
+    SENSOR_SQ(file, 0), SENSOR_SQ(file, 1), SENSOR_SQ(file, 2), SENSOR_SQ(file, 3), \
+    SENSOR_SQ(file, 4), SENSOR_SQ(file, 5), SENSOR_SQ(file, 6), SENSOR_SQ(file, 7)
+
+#if SENSOR_MCP23017
+// Two neighbouring files per chip, port A the lower one
+static const uint8_t sensor_map[SENSOR_CHIPS][SENSOR_PINS] PROGMEM = {
+    {SENSOR_FILE(0), SENSOR_FILE(1)},
+    {SENSOR_FILE(2), SENSOR_FILE(3)},
+    {SENSOR_FILE(4), SENSOR_FILE(5)},
+    {SENSOR_FILE(6), SENSOR_FILE(7)},
+};
+#else
+// One file per chip: chip 0 is the a file
+static const uint8_t sensor_map[SENSOR_CHIPS][SENSOR_PINS] PROGMEM = {
+    {SENSOR_FILE(0)}, {SENSOR_FILE(1)}, {SENSOR_FILE(2)}, {SENSOR_FILE(3)},
+    {SENSOR_FILE(4)}, {SENSOR_FILE(5)}, {SENSOR_FILE(6)}, {SENSOR_FILE(7)},
+};
+#endif
+
+#endif
@@ -0,0 +1,74 @@
+#include "sensors.h"
+#include "i2c.h"
+#include "profile.h"
+#include <avr/pgmspace.h>
+#include <stdio.h>
+#include "sensor_map.h"
+
+static uint8_t chip_files[SENSOR_CHIPS];    // files each chip has a switch in (bit = file)
+
+// Set up every expander that doesn't still hold its setup from before a reset. Returns
+// false if any chip failed; the scan then reports its files as unreadable.
+bool sensors_init(void) {
+    bool ok = true;
+    for (uint8_t chip = 0; chip < SENSOR_CHIPS; chip++) {
+        chip_files[chip] = 0;
+        for (uint8_t pin = 0; pin < SENSOR_PINS; pin++) {
+            uint8_t sq = pgm_read_byte(&sensor_map[chip][pin]);
+            if (sq != SENSOR_NC) chip_files[chip] |= (uint8_t)(1 << (sq >> 3));
+        }
+#if SENSOR_MCP23017
+        if (mcp23017_inputs_configured(chip)) {
+#else
+        if (mcp23008_inputs_configured(chip)) {
+#endif
+            printf_P(PSTR("TWI on %u already set up\n"), chip);
+            continue;
+        }
+#if SENSOR_MCP23017
+        twi_error_t status = initialize_mcp23017_inputs(chip);
+#else
+        twi_error_t status = initialize_mcp23008_inputs(chip);
+#endif
+        if (status != TWI_SUCCESS) {
+            printf_P(PSTR("ERROR: on chip %u, status: %u\n"), chip, status);
+            ok = false;
+        } else {
+            printf_P(PSTR("TWI on %u START SUCESS\n"), chip);
+        }
+    }
+    printf_P(PSTR("SENSORS: %u x %s, %u transactions per scan\n"), SENSOR_CHIPS,
+             SENSOR_MCP23017 ? "MCP23017" : "MCP23008", SENSOR_CHIPS);
+    return ok;
+}
+
+// Read the columns of `files` (bit = file), one transaction per chip that has a switch in
+// any of them. Only those columns are written. Returns the files that couldn't be read.
+uint8_t sensors_read(uint8_t files, uint8_t columns[8]) {
+    uint8_t failed = 0;
+    for (uint8_t file = 0; file < 8; file++) {
+        if ((files >> file) & 1) columns[file] = 0;
+    }
+    for (uint8_t chip = 0; chip < SENSOR_CHIPS; chip++) {
+        if (!(chip_files[chip] & files)) continue;
+        uint8_t data[SENSOR_PINS / 8];
+        PROFILE_BEGIN(t_read);
+#if SENSOR_MCP23017
+        twi_error_t status = mcp_read_registers(chip, MCP23017_GPIOA_REG, data, 2);
+#else
+        twi_error_t status;
+        data[0] = mcp_read_register(chip, MCP23008_GPIO_REG, &status);
+#endif
+        PROFILE_END(PROF_TWI_READ, t_read);
+        if (status != TWI_SUCCESS) {
+            failed |= chip_files[chip] & files;
+            continue;
+        }
+        for (uint8_t pin = 0; pin < SENSOR_PINS; pin++) {
+            uint8_t sq = pgm_read_byte(&sensor_map[chip][pin]);
+            if (sq == SENSOR_NC || !((files >> (sq >> 3)) & 1)) continue;
+            if ((data[pin >> 3] >> (pin & 7)) & 1) columns[sq >> 3] |= (uint8_t)(1 << (sq & 7));
+        }
+    }
+    return failed;
+}
@@ -0,0 +1,31 @@
+#ifndef SENSORS_H
+#define SENSORS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Reed switch scanning over the I2C expanders. The board is either eight MCP23008s (one
+// file each, one transaction per chip) or, built with -DSENSOR_MCP23017=1, four MCP23017s
+// that return both their ports in one sequential read: half the transactions per scan.
+// Which pin sees which square is the table in sensor_map.h, so another wiring only needs
+// that table changed.
+//
+// Readings come back as sensor columns, as everywhere else: byte = file, bit = rank.
+#ifndef SENSOR_MCP23017
+#define SENSOR_MCP23017 0
+#endif
+
+#if SENSOR_MCP23017
+#define SENSOR_CHIPS 4
+#define SENSOR_PINS 16
+#else
+#define SENSOR_CHIPS 8
+#define SENSOR_PINS 8
+#endif
+
+#define SENSOR_ALL_FILES 0xFF
+
+bool sensors_init(void);
+uint8_t sensors_read(uint8_t files, uint8_t columns[8]);
+
+#endif
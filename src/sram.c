@@ -0,0 +1,51 @@
+#include "sram.h"
+#include "uart_esp.h"
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <stdio.h>
+
+extern uint8_t _end;        // end of .bss, from the linker
+extern uint8_t __stack;     // top of RAM
+
+// Runs from .init1, before the stack pointer and the zero register are set up, so it
+// can't use either: plain assembly, no calls, no stack
+void sram_paint(void) __attribute__((naked, used, section(".init1")));
+void sram_paint(void) {
+    __asm volatile(
+        "    ldi r30, lo8(_end)\n"
+        "    ldi r31, hi8(_end)\n"
+        "    ldi r24, %0\n"
+        "    ldi r25, hi8(__stack)\n"
+        "    rjmp 2f\n"
+        "1:  st Z+, r24\n"
+        "2:  cpi r30, lo8(__stack)\n"
+        "    cpc r31, r25\n"
+        "    brlo 1b\n"
+        "    breq 1b\n"
+        :: "M"(SRAM_CANARY));
+}
+
+void sram_usage(sram_usage_t* usage) {
+    const uint8_t* p = &_end;
+    uint16_t untouched = 0;
+    while (p <= &__stack && *p == SRAM_CANARY) {
+        p++;
+        untouched++;
+    }
+    usage->total = RAMEND - RAMSTART + 1;
+    usage->data = (uint16_t)(&_end - (uint8_t*)RAMSTART);
+    usage->headroom = untouched;
+    usage->stack_peak = usage->total - usage->data - untouched;
+}
+
+// "mem" from the ESP: printed here and sent back as a "mem:" line
+void sram_report(void) {
+    sram_usage_t usage;
+    char buf[72];
+    sram_usage(&usage);
+    snprintf_P(buf, sizeof(buf), PSTR("mem:sram %u data+bss %u stack peak %u never used %u"),
+               usage.total, usage.data, usage.stack_peak, usage.headroom);
+    printf_P(PSTR("%s\n"), buf);
+    uart1_send_string(buf);
+    uart1_send_byte('\n');
+}
@@ -0,0 +1,23 @@
+#ifndef SRAM_H
+#define SRAM_H
+
+#include <stdint.h>
+
+// SRAM use at run time. Before .data and .bss are set up, everything from the end of
+// .bss (_end) up to the top of RAM is painted with SRAM_CANARY. The stack grows down into
+// that area and overwrites the paint, so the paint still left above _end is how close
+// the stack has ever come to the static data. There is no heap (nothing calls malloc).
+// The static sizes per module are checked at build time by host/mem_budget.py.
+#define SRAM_CANARY 0xC5
+
+typedef struct {
+    uint16_t total;         // RAMEND - RAMSTART + 1
+    uint16_t data;          // .data + .bss
+    uint16_t stack_peak;    // deepest the stack has been
+    uint16_t headroom;      // never touched between the static data and the stack
+} sram_usage_t;
+
+void sram_usage(sram_usage_t* usage);
+void sram_report(void);
+
+#endif
@@ -0,0 +1,141 @@
+#include "stepgen.h"
+#include "profile.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+/*
+Motor 1: STEP PB1, DIR PD4
+Motor 2: STEP PD0, DIR PD6
+*/
+#define STEPGEN_CYCLES_PER_TICK (F_CPU / (2 * STEPGEN_STEP_HZ))
+
+static volatile uint16_t steps_left;    // ticks of the major axis still to go
+static volatile uint8_t step_high;      // step pins are up, drop them next tick
+static uint16_t major;                  // steps of the motor that moves most
+static uint16_t n1, n2;                 // steps of each motor
+static uint16_t acc1, acc2;             // DDA error terms
+static volatile uint16_t stopped_left;  // steps cut off by the last stepgen_stop()
+static volatile uint16_t isr_max_ticks;
+
+void stepgen_init(void) {
+    TCCR1A = 0;
+    TCNT1 = 0;
+    OCR1A = STEPGEN_CYCLES_PER_TICK / STEPGEN_PRESCALE - 1;
+    TCCR1B = (1 << WGM12) | (1 << CS11);    // CTC, F_CPU/8
+    // the compare interrupt is only on while a move runs, see stepgen_move()
+}
+
+// Step rate of the major axis for the following moves, at least 16 steps/s (OCR1A is
+// 16 bits). Waits for the running move first.
+void stepgen_set_rate(uint16_t steps_per_s) {
+    while (stepgen_busy());
+    OCR1A = (uint16_t)(F_CPU / STEPGEN_PRESCALE / (2UL * steps_per_s) - 1);
+}
+
+// Start a straight move of steps1 / steps2 steps (sign = direction). Waits for the
+// previous move to finish first.
+void stepgen_move(int16_t steps1, int16_t steps2) {
+    while (stepgen_busy());
+    if (steps1 >= 0) PORTD |= (1 << PD4);
+    else PORTD &= ~(1 << PD4);
+    if (steps2 >= 0) PORTD |= (1 << PD6);
+    else PORTD &= ~(1 << PD6);
+
+    n1 = (uint16_t)(steps1 >= 0 ? steps1 : -steps1);
+    n2 = (uint16_t)(steps2 >= 0 ? steps2 : -steps2);
+    major = n1 > n2 ? n1 : n2;
+    // start half way so the minor axis steps fall in the middle of their interval
+    acc1 = acc2 = major / 2;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        stopped_left = 0;
+        steps_left = major;
+        // a full tick to the first step, whatever the timer did while idle
+        TCNT1 = 0;
+        TIFR1 = (1 << OCF1A);
+        TIMSK1 |= (1 << OCIE1A);
+    }
+}
+
+// Stop at once (limit switches, cancelled pre-positioning); returns the major-axis steps
+// that were not made
+uint16_t stepgen_stop(void) {
+    uint16_t left;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        left = steps_left;
+        steps_left = 0;
+        stopped_left += left;
+    }
+    return left;
+}
+
+// Major-axis steps the last move has made so far, counting a stop
+uint16_t stepgen_steps_done(void) {
+    uint16_t done;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        done = major - steps_left - stopped_left;
+    }
+    return done;
+}
+
+bool stepgen_busy(void) {
+    bool busy;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        busy = steps_left != 0 || step_high;
+    }
+    return busy;
+}
+
+uint16_t stepgen_remaining(void) {
+    uint16_t left;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        left = steps_left;
+    }
+    return left;
+}
+
+uint16_t stepgen_isr_max_cycles(void) {
+    uint16_t ticks;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ticks = isr_max_ticks;
+    }
+    return (uint16_t)(ticks * STEPGEN_PRESCALE);
+}
+
+uint32_t stepgen_cycles_per_tick(void) {
+    return STEPGEN_CYCLES_PER_TICK;
+}
+
+ISR(TIMER1_COMPA_vect) {
+    PROFILE_BEGIN(t_isr);
+    if (step_high) {
+        PORTB &= ~(1 << PB1);
+        PORTD &= ~(1 << PD0);
+        step_high = 0;
+    } else if (steps_left) {
+        steps_left--;
+        acc1 += n1;
+        if (acc1 >= major) {
+            acc1 -= major;
+            PORTB |= (1 << PB1);
+        }
+        acc2 += n2;
+        if (acc2 >= major) {
+            acc2 -= major;
+            PORTD |= (1 << PD0);
+        }
+        step_high = 1;
+    } else {
+        // the tick after the last step pulse ended (or after stepgen_stop()): nothing
+        // to do until the next move, so stop ticking; this is also the wake-up for a
+        // main loop asleep in idle_wait()
+        TIMSK1 &= ~(1 << OCIE1A);
+    }
+    // TCNT1 restarted from 0 at the compare match: this is the time to get here
+    uint16_t t = TCNT1;
+    if (t > isr_max_ticks) isr_max_ticks = t;
+    PROFILE_END(PROF_STEP_ISR, t_isr);
+}
@@ -0,0 +1,29 @@
+#ifndef STEPGEN_H
+#define STEPGEN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Step pulses for both motors from one timer. Timer1 (CTC) interrupts at twice the step
+// rate: one tick raises the step pins, the next drops them. Each move is a DDA
+// (Bresenham) line, so the motor with more steps steps every other tick and the other one
+// is spread evenly between them. Both start and finish on the same tick, whatever the
+// ratio. Between moves the timer keeps counting but doesn't interrupt. Timer3 makes the magnet PWM (src/magnet.c).
+//
+// Tick budget: 16 MHz / 400 Hz = 40000 cycles. The ISR should take about 120 cycles
+// (0.3 %). stepgen_isr_max_cycles() holds the longest it has actually taken, from the
+// compare match to the end of the ISR, to Timer1's resolution of 8 cycles.
+#define STEPGEN_STEP_HZ 200UL       // steps per second of the motor with more steps
+#define STEPGEN_PRESCALE 8UL
+
+void stepgen_init(void);
+void stepgen_set_rate(uint16_t steps_per_s);
+void stepgen_move(int16_t steps1, int16_t steps2);
+uint16_t stepgen_stop(void);
+uint16_t stepgen_steps_done(void);
+bool stepgen_busy(void);
+uint16_t stepgen_remaining(void);
+uint16_t stepgen_isr_max_cycles(void);
+uint32_t stepgen_cycles_per_tick(void);
+
+#endif
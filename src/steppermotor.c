@@ -1,26 +1,80 @@
 #include "steppermotor.h"
+#include "stepgen.h"
+#include "magnet.h"
+#include "gantry_plan.h"
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 #include <util/delay.h>
 #include <string.h>
 #include <stdlib.h>
+#include <math.h>
+#include <stdio.h>
 //#include "uart.h"
 /*
 PD2: Switch for Motor 1
 PD3: Switch for Motor 2
-PB1: Motor 1 DIR
-PD5: Motor 1 STEP
+PD4: Motor 1 DIR
+PB1: Motor 1 STEP
 PD6: Motor 2 DIR
 PD0: Motor 2 STEP
+Step pulses come from src/stepgen.c (Timer1), the magnet PWM on PD1 from src/magnet.c.
 */
 #define F_CPU 16000000UL
 
-volatile uint32_t counter1 = 0;
-volatile uint32_t counter2 = 0;
+#define STEPS_PER_TURN 200
+
+// Axis scale in steps per square and backlash in steps, STEPS_PER_SQUARE_X/Y until
+// motion_set_scale() loads a calibration (src/calibrate.c). The belts are an H-bot: x
+// turns both motors the same way, y turns them opposite ways (motor 1 backward for +y,
+// toward rank 1).
+static float steps_per_square_x = STEPS_PER_SQUARE_X;
+static float steps_per_square_y = STEPS_PER_SQUARE_Y;
+static uint8_t backlash_x = 0, backlash_y = 0;
+static int8_t last_dir_x = 0, last_dir_y = 0;     // direction of the last move on each axis
+static uint8_t calibrated = 0;
+
+#define HOME_X 0
+#define HOME_Y 1
+#define HOME_MAX_SQUARES 10         // more than either axis can travel: a switch that never closes is a fault
+#define HOME_BACKOFF_SQUARES 0.25
+#define HOME_SLOW_HZ 40
+#define HOME_Y_OFFSET -0.811        // the y switch closes this far (in head y) past the centre of rank 8
+
+homing_stats_t homing_stats;
+static volatile uint8_t limit_hit;  // set by the limit switch interrupts
 
 //stepper motor position tracking variables
 uint32_t global_step_pos_x = 0;
 uint32_t global_step_pos_y = 0;
 
+// Head position in squares from home, as move_motor() counts them (x toward file h,
+// y toward rank 1). Dead-reckoned by x_axis()/y_axis(), exact again after init_pos().
+float head_x = 0.0;
+float head_y = 0.0;
+
+// Speculative pre-positioning: an x leg then a y leg, driven from the main loop
+typedef enum {
+    PREPOS_IDLE,
+    PREPOS_X,
+    PREPOS_Y,
+} prepos_state_t;
+
+static prepos_state_t prepos_state = PREPOS_IDLE;
+static float prepos_target_x, prepos_target_y;
+static float prepos_leg_squares;     // signed length of the running leg
+static uint16_t prepos_leg_steps;    // major-axis steps the leg started with
+
+#define HEAD_EPSILON 0.05
+#define MASK_REACH 0.75     // half a square, plus how far off-centre a reed switch still trips
+
+// Squares a dragged piece (or the magnet) has passed near since motion_mask_clear(), as
+// sensor column bytes: byte = file, bit = rank
+uint8_t motion_mask[8];
+
+// Called while waiting for the step timers and during settle pauses
+static void (*motion_poll)(void) = 0;
+#define NUDGE_SQUARES 0.25
+
 const uint32_t step_per_square = 1600; //200 steps per rev, 8 microsteps, 1 rev per 4mm, 20mm per square
 
 int square_to_steps(int squares){
@@ -31,8 +85,34 @@ int squares_to_counts(int squares){
     return squares * 200 * 2;
 }
 
+static int16_t turns_to_steps(float turns) {
+    return (int16_t)lround(turns * STEPS_PER_TURN);
+}
+
+void motion_set_scale(float x, float y, uint8_t lash_x, uint8_t lash_y) {
+    steps_per_square_x = x;
+    steps_per_square_y = y;
+    backlash_x = lash_x;
+    backlash_y = lash_y;
+    calibrated = 1;
+}
+
+uint8_t motion_is_calibrated(void) {
+    return calibrated;
+}
+
+// Axis steps for a move of `squares`, plus the backlash when the axis reverses
+static float axis_steps(float squares, float scale, uint8_t backlash, int8_t* last_dir) {
+    float steps = squares * scale;
+    if (squares == 0) return 0;
+    int8_t dir = squares > 0 ? 1 : -1;
+    if (*last_dir && dir != *last_dir) steps += dir * backlash;
+    *last_dir = dir;
+    return steps;
+}
+
 void motor_init(void) {
-    DDRD |= (1 << PD1);
+    magnet_init();
     DDRD |= (1 << PD4) | (1 << PD6);    
     DDRD &= ~((1 << PD2) | (1 << PD3));
     PORTD |= (1 << PD2) | (1 << PD3);
@@ -40,116 +120,95 @@ void motor_init(void) {
     DDRD |= (1 << PD0);
     EICRA |= (1 << ISC11) | (1 << ISC01);
     EICRA &= ~((1 << ISC10) | (1 << ISC00));
-    TCCR1A = 0; 
-    TCCR1B = (1 << WGM12) | (1 << CS11) | (1 << CS10); 
-    OCR1A = (16000000UL / (2 * 64 * 200)) - 1; 
-    TIMSK1 |= (1 << OCIE1A);
-    PRR1 &= ~(1 << PRTIM3);
-    TCCR3A = 0;
-    TCNT3 = 0;
-    TCCR3B = (1 << WGM32) | (1 << CS31) | (1 << CS30);
-    OCR3A = (16000000UL / (2 * 64 * 200)) - 1;
-    TIMSK3 |= (1 << OCIE3A);     
+    stepgen_init();
     sei();
 }
 
-void wait_stop_1(void){
-    while (counter1 > 0);
+void motion_set_poll(void (*poll)(void)) {
+    motion_poll = poll;
 }
-void wait_stop_2(void){
-    while (counter2 > 0);
+
+void motion_mask_clear(void) {
+    memset(motion_mask, 0, sizeof(motion_mask));
 }
 
-void rotate1(float turns, uint8_t dir){
-    wait_stop_1();
-    if (dir){
-        PORTD |= (1 << PD4);
-    }
-    else{
-        PORTD &= ~(1 << PD4);    
-    }
-    
-    counter1 = turns * 200 * 2;
-    if (counter1 > 0) {
-        TCCR1A |= (1 << COM1A0);
+// Add every square within MASK_REACH of the leg (x0, y0) -> (x1, y1). Only legs with the
+// magnet on disturb the reed switches.
+static void mask_leg(float x0, float y0, float x1, float y1) {
+    if (!magnet_is_on()) return;
+    int8_t x_lo = (int8_t)ceil(fmin(x0, x1) - MASK_REACH);
+    int8_t x_hi = (int8_t)floor(fmax(x0, x1) + MASK_REACH);
+    int8_t y_lo = (int8_t)ceil(fmin(y0, y1) - MASK_REACH);
+    int8_t y_hi = (int8_t)floor(fmax(y0, y1) + MASK_REACH);
+    for (int8_t x = x_lo < 0 ? 0 : x_lo; x <= x_hi && x < 8; x++) {
+        for (int8_t y = y_lo < 0 ? 0 : y_lo; y <= y_hi && y < 8; y++) {
+            motion_mask[x] |= (uint8_t)(1 << (7 - y));
+        }
     }
 }
 
-
-void rotate2(float turns, uint8_t dir){
-    wait_stop_2();
-    if (dir){
-        PORTD |= (1 << PD6);
-    }
-    else{
-        PORTD &= ~(1 << PD6);
-    }
-    counter2 = turns * 200 * 2;
-    if (counter2 > 0) {
-        TCCR3A |= (1 << COM3A0);
+// _delay_ms() needs a constant; pause in 1 ms steps so the poll keeps running
+static void motion_pause_ms(uint32_t ms) {
+    while (ms--) {
+        _delay_ms(1);
+        if (motion_poll) motion_poll();
     }
 }
 
-ISR(TIMER1_COMPA_vect){
-    if (counter1 > 0){
-        counter1--;
-    } 
-    else {
-        TCCR1A &= ~(1 << COM1A0);
+// Both motors run from the one step generator, so both waits wait for the same move
+void wait_stop_1(void){
+    while (stepgen_busy()) {
+        if (motion_poll) motion_poll();
     }
 }
+void wait_stop_2(void){
+    wait_stop_1();
+}
 
-ISR(TIMER3_COMPA_vect){
-    if (counter2 > 0){
-        counter2--;
-    }
-    else {
-        TCCR3A &= ~(1 << COM3A0);
-    }
+// Single motor moves, for bench testing one belt
+void rotate1(float turns, uint8_t dir){
+    int16_t steps = turns_to_steps(turns);
+    stepgen_move(dir ? steps : -steps, 0);
+}
+
+void rotate2(float turns, uint8_t dir){
+    int16_t steps = turns_to_steps(turns);
+    stepgen_move(0, dir ? steps : -steps);
 }
 
 ISR(INT0_vect){
-    counter1 = 0;
-    counter2 = 0;
-    TCCR1A &= ~(1 << COM1A0);
-    TCCR3A &= ~(1 << COM3A0);
+    stepgen_stop();
+    limit_hit = 1;
 }
 
 ISR(INT1_vect) {
-    counter2 = 0; 
-    counter1 = 0;
-    TCCR1A &= ~(1 << COM1A0);
-    TCCR3A &= ~(1 << COM3A0);
+    stepgen_stop();
+    limit_hit = 1;
+}
+
+// Move the head (dx, dy) squares in a straight line: both motors start together and the
+// shorter one's steps are spread over the longer one's
+void xy_move(float dx, float dy) {
+    float x1 = head_x + dx;
+    float y1 = head_y + dy;
+    float ax = axis_steps(dx, steps_per_square_x, backlash_x, &last_dir_x);
+    float ay = axis_steps(dy, steps_per_square_y, backlash_y, &last_dir_y);
+    mask_leg(head_x, head_y, x1, y1);
+    stepgen_move((int16_t)lround(ax - ay), (int16_t)lround(ax + ay));
+    head_x = x1;
+    head_y = y1;
 }
 
 void x_axis(float squares,  uint8_t dir){
     //1 turn = 4.2cm 
     //1 square = 3.7cm
-    float turns = 0.9 * squares;
-    rotate1(turns, dir);
-    rotate2(turns, dir);
-//    if (dir) global_step_pos_x += square_to_steps(squares);
-//    else     global_step_pos_x -= square_to_steps(squares);
+    xy_move(dir ? squares : -squares, 0);
 }
 
 void y_axis(float squares,  uint8_t dir){
     //1 turn = 4cm
     //1 square = 3.7cm
-    float turns = 0.925 * squares;
-    uint8_t dir1 = 1;
-    uint8_t dir2 = 0;
-    if (dir){
-        dir1 = 1;
-        dir2 = 0;
-    }
-    else{
-        dir1 = 0;
-        dir2 = 1;
-    }
-    rotate1(turns, dir1);
-    rotate2(turns, dir2);
-//    if (dir) global_step_pos_x += square_to_steps(squares);
-//    else     global_step_pos_x -= square_to_steps(squares);    
+    xy_move(0, dir ? -squares : squares);
 }
 
 void test(void){
@@ -159,71 +218,177 @@ void test(void){
 //    x_axis(1.0, 0);
 }
 
-void init_pos(void){
-    if(PIND & (1 << PD2)){
-        EIFR |= (1 << INTF0);
-        EIMSK |= (1 << INT0);    
-        x_axis(100, 1);
-        wait_stop_1(); 
-        wait_stop_2();
+// Drive one axis toward (or away from) its limit switch, at most `steps` axis steps at
+// `rate` steps/s, stopping early if the switch closes while watched. Returns the steps
+// made and adds the time they took to homing_stats.
+static uint16_t home_leg(uint8_t axis, uint16_t steps, uint8_t toward, uint8_t watch, uint16_t rate) {
+    uint8_t int_bit = axis == HOME_X ? INT0 : INT1;
+    int16_t s = toward ? (int16_t)steps : -(int16_t)steps;
+
+    stepgen_set_rate(rate);
+    limit_hit = 0;
+    if (watch) {
+        EIFR |= (1 << (axis == HOME_X ? INTF0 : INTF1));
+        EIMSK |= (1 << int_bit);
+    }
+    // toward the switches is +x (both motors forward) and -y (motor 1 forward, motor 2 back)
+    if (axis == HOME_X) stepgen_move(s, s);
+    else stepgen_move(s, (int16_t)-s);
+    wait_stop_1();
+    EIMSK &= ~(1 << int_bit);
+    stepgen_set_rate(STEPGEN_STEP_HZ);
+
+    uint16_t done = stepgen_steps_done();
+    homing_stats.last_ms += (uint32_t)done * 1000 / rate;
+    return done;
+}
+
+static uint8_t switch_closed(uint8_t axis) {
+    return !(PIND & (1 << (axis == HOME_X ? PD2 : PD3)));
+}
 
-        EIMSK &= ~(1 << INT0);
+// Home one axis: fast approach, back off, slow approach. The slow approach's length is
+// the switch's repeatability; its spread is kept in homing_stats.
+static uint8_t home_axis(uint8_t axis, float steps_per_square) {
+    uint16_t max_steps = (uint16_t)(HOME_MAX_SQUARES * steps_per_square);
+    uint16_t backoff = (uint16_t)(HOME_BACKOFF_SQUARES * steps_per_square);
+    char name = axis == HOME_X ? 'x' : 'y';
+
+    if (!switch_closed(axis)) {
+        home_leg(axis, max_steps, 1, 1, STEPGEN_STEP_HZ);
+        if (!limit_hit) {
+            printf_P(PSTR("HOMING: %c switch not reached in %u steps\n"), name, max_steps);
+            return 0;
+        }
+    }
+    home_leg(axis, backoff, 0, 0, STEPGEN_STEP_HZ);
+    if (switch_closed(axis)) {
+        printf_P(PSTR("HOMING: %c switch still closed after backing off\n"), name);
+        return 0;
+    }
+    uint16_t slow = home_leg(axis, 2 * backoff, 1, 1, HOME_SLOW_HZ);
+    if (!limit_hit) {
+        printf_P(PSTR("HOMING: %c switch not found on the slow approach\n"), name);
+        return 0;
+    }
+    if (homing_stats.runs == 0 || slow < homing_stats.slow_min[axis]) homing_stats.slow_min[axis] = slow;
+    if (homing_stats.runs == 0 || slow > homing_stats.slow_max[axis]) homing_stats.slow_max[axis] = slow;
+    return 1;
+}
 
-        global_step_pos_x = 0;
-        _delay_ms(1000);
+// Home both axes and move to the centre of a8, head (0, 0). Returns 0 and reports a fault
+// if a switch doesn't respond; the head position is then unknown.
+uint8_t init_pos(void){
+    homing_stats.last_ms = 0;
+    if (!home_axis(HOME_X, steps_per_square_x) || !home_axis(HOME_Y, steps_per_square_y)) {
+        homing_stats.faults++;
+        return 0;
     }
-    
-    if(PIND & (1 << PD3)){
-        EIFR |= (1 << INTF1);
-        EIMSK |= (1 << INT1);
-        y_axis(100, 1);
-        wait_stop_1();
-        wait_stop_2();
+    homing_stats.runs++;
+
+    // both axes last moved toward their switches: +x and -y
+    last_dir_x = 1;
+    last_dir_y = -1;
+    head_x = 0.0;
+    head_y = HOME_Y_OFFSET;
+    xy_move(0, -HOME_Y_OFFSET);
+    wait_stop_1();
+    homing_stats.last_ms += (uint32_t)(-HOME_Y_OFFSET * steps_per_square_y * 1000 / STEPGEN_STEP_HZ);
+    head_y = 0.0;
+
+    printf_P(PSTR("HOMING: %lu ms, slow approach x %u..%u y %u..%u steps over %u runs\n"),
+             (unsigned long)homing_stats.last_ms,
+             homing_stats.slow_min[HOME_X], homing_stats.slow_max[HOME_X],
+             homing_stats.slow_min[HOME_Y], homing_stats.slow_max[HOME_Y], homing_stats.runs);
+    return 1;
+}
+
+// Start the next pre-positioning leg, skipping legs that are already there
+static void prepos_next_leg(void) {
+    if (prepos_state == PREPOS_X) {
+        prepos_leg_squares = prepos_target_x - head_x;
+        if (fabs(prepos_leg_squares) > HEAD_EPSILON) {
+            x_axis(fabs(prepos_leg_squares), prepos_leg_squares > 0);
+            prepos_leg_steps = stepgen_remaining();
+            return;
+        }
+        prepos_state = PREPOS_Y;
+    }
+    if (prepos_state == PREPOS_Y) {
+        prepos_leg_squares = prepos_target_y - head_y;
+        if (fabs(prepos_leg_squares) > HEAD_EPSILON) {
+            y_axis(fabs(prepos_leg_squares), prepos_leg_squares > 0 ? 0 : 1);
+            prepos_leg_steps = stepgen_remaining();
+            return;
+        }
+        prepos_state = PREPOS_IDLE;
+    }
+}
 
-        EIMSK &= ~(1 << INT1);
+// Drive the head toward (x, y) without blocking; the magnet stays off
+void prepos_start(float x, float y) {
+    prepos_cancel();
+    prepos_target_x = x;
+    prepos_target_y = y;
+    prepos_state = PREPOS_X;
+    prepos_next_leg();
+}
 
-        global_step_pos_y = 0;
+// Call from the main loop: moves on to the y leg once the x leg has finished
+void prepos_service(void) {
+    if (prepos_state == PREPOS_IDLE || stepgen_busy()) return;
+    if (prepos_state == PREPOS_X) {
+        prepos_state = PREPOS_Y;
+        prepos_next_leg();
+    } else {
+        prepos_state = PREPOS_IDLE;
+    }
+}
 
-        _delay_ms(500);
+// Stop pre-positioning at once and book only the part of the leg actually travelled
+void prepos_cancel(void) {
+    if (prepos_state == PREPOS_IDLE) return;
+    uint16_t remaining = stepgen_stop();
+    if (remaining > 0 && prepos_leg_steps > 0) {
+        float untravelled = prepos_leg_squares * ((float)remaining / prepos_leg_steps);
+        if (prepos_state == PREPOS_X) head_x -= untravelled;
+        else head_y -= untravelled;
     }
-    
-    EIFR |= (1 << INTF1);
-    EIMSK |= (1 << INT1);
-    y_axis(0.811, 0);
-    wait_stop_1();
-    wait_stop_2();
-    
-    EIMSK &= ~(1 << INT1);
-    
-    global_step_pos_y = 0;
-    
-    _delay_ms(500);
+    prepos_state = PREPOS_IDLE;
 }
 
-void move_motor(char* line) {
-    uint8_t start_x = line[0] - 'a'; 
-    uint8_t start_y = '8' - line[1]; 
-    uint8_t end_x   = line[2] - 'a';
-    uint8_t end_y   = '8' - line[3];
+uint8_t prepos_active(void) {
+    return prepos_state != PREPOS_IDLE;
+}
+
+// Carry the piece on line[0..1] to line[2..3] and set it down. The head stays over the
+// target square so the placement can be checked and nudged before re-homing.
+void move_piece(const char* line) {
+    // signed: the graveyard (rank 9) is one row past rank 8, y = -1
+    int8_t start_x = line[0] - 'a'; 
+    int8_t start_y = '8' - line[1]; 
+    int8_t end_x   = line[2] - 'a';
+    int8_t end_y   = '8' - line[3];
     
-    float dist_x = (float)start_x;
-    if (dist_x > 0) {
-        x_axis(dist_x, 1);
+    // travel from wherever the head is (home, or a pre-positioning point) to the source
+    float dist_x = (float)start_x - head_x;
+    if (fabs(dist_x) > HEAD_EPSILON) {
+        x_axis(fabs(dist_x), dist_x > 0);
         wait_stop_1(); 
         wait_stop_2(); 
-        _delay_ms(10000);
+        motion_pause_ms(GANTRY_SETTLE_MS);
     }
 
-    float dist_y = (float)start_y;
-    if (dist_y > 0) {
-        y_axis(dist_y, 0);
+    float dist_y = (float)start_y - head_y;
+    if (fabs(dist_y) > HEAD_EPSILON) {
+        y_axis(fabs(dist_y), dist_y > 0 ? 0 : 1);
         wait_stop_1(); 
         wait_stop_2(); 
-        _delay_ms(10000);
+        motion_pause_ms(GANTRY_SETTLE_MS);
     }
 
-    PORTD |= (1 << PD1); 
-    _delay_ms(100000); 
+    magnet_on();
+    motion_pause_ms(MAGNET_PULLIN_MS);
     
     uint8_t enable_x_offset = 1;
     uint8_t enable_y_offset = 1;
@@ -246,14 +411,14 @@ void move_motor(char* line) {
             current_off_x = -0.5;
         }
         wait_stop_1(); wait_stop_2();
-        _delay_ms(10000);
+        motion_pause_ms(GANTRY_SETTLE_MS);
     }
 
     if (enable_y_offset) {
         y_axis(0.5, 0); 
         current_off_y = 0.5;
         wait_stop_1(); wait_stop_2();
-        _delay_ms(10000);
+        motion_pause_ms(GANTRY_SETTLE_MS);
     }
 
     float target_off_x = 0.0;
@@ -274,28 +439,53 @@ void move_motor(char* line) {
     if (move_x != 0) {
         x_axis(fabs(move_x), (move_x > 0) ? 1 : 0);
         wait_stop_1(); wait_stop_2();
-        _delay_ms(10000);
+        motion_pause_ms(GANTRY_SETTLE_MS);
     }
 
     if (move_y != 0) {
         y_axis(fabs(move_y), (move_y > 0) ? 0 : 1);
         wait_stop_1(); wait_stop_2();
-        _delay_ms(10000);
+        motion_pause_ms(GANTRY_SETTLE_MS);
     }
 
     if (target_off_y != 0) {
         y_axis(0.5, 0);
         wait_stop_1(); wait_stop_2();
-        _delay_ms(10000);
+        motion_pause_ms(GANTRY_SETTLE_MS);
     }
 
     if (target_off_x != 0) {
         x_axis(0.5, (target_off_x > 0) ? 0 : 1);
         wait_stop_1(); wait_stop_2();
-        _delay_ms(10000);
+        motion_pause_ms(GANTRY_SETTLE_MS);
     }
 
-    PORTD &= ~(1 << PD1); 
-    _delay_ms(10000);   
+    magnet_off();
+    motion_pause_ms(MAGNET_RELEASE_MS);
+}
+
+// Recentre a piece that stopped short of the square under the head: pick it up and drag
+// it round a small loop about the centre, toward the middle of the board so the loop
+// never runs into the end stops. The head finishes where it started.
+void nudge_piece(void) {
+    uint8_t dir_x = head_x < 3.5;
+    uint8_t dir_y = head_y > 3.5;
+
+    magnet_on();
+    motion_pause_ms(MAGNET_PULLIN_MS);
+    x_axis(NUDGE_SQUARES, dir_x);
+    wait_stop_1(); wait_stop_2();
+    y_axis(NUDGE_SQUARES, dir_y);
+    wait_stop_1(); wait_stop_2();
+    x_axis(NUDGE_SQUARES, !dir_x);
+    wait_stop_1(); wait_stop_2();
+    y_axis(NUDGE_SQUARES, !dir_y);
+    wait_stop_1(); wait_stop_2();
+    magnet_off();
+    motion_pause_ms(MAGNET_RELEASE_MS);
+}
+
+void move_motor(char* line) {
+    move_piece(line);
     init_pos();
 }
\ No newline at end of file
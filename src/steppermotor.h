@@ -1,14 +1,43 @@
 #include <avr/io.h>
 #include <stdint.h>
 
+// Nominal axis scale, steps per square: 0.9 / 0.925 motor turns of 200 steps
+#define STEPS_PER_SQUARE_X 180.0f
+#define STEPS_PER_SQUARE_Y 185.0f
+
 void motor_init(void);
 void rotate1(float turns, uint8_t dir);
 void rotate2(float turns, uint8_t dir);
-void init_pos(void);
+uint8_t init_pos(void);
 void wait_stop_1(void);
 void wait_stop_2(void);
 void y_axis(float squares,  uint8_t dir);
 void x_axis(float squares,  uint8_t dir);
+void xy_move(float dx, float dy);
 void test(void);
 void move_motor(char* line);
+void move_piece(const char* line);
+void nudge_piece(void);
+void prepos_start(float x, float y);
+void prepos_service(void);
+void prepos_cancel(void);
+uint8_t prepos_active(void);
+
+void motion_set_poll(void (*poll)(void));
+void motion_set_scale(float x, float y, uint8_t lash_x, uint8_t lash_y);
+uint8_t motion_is_calibrated(void);
+void motion_mask_clear(void);
+
+// Homing figures: the slow approach's length in steps is the limit switch repeatability
+typedef struct {
+    uint16_t runs;
+    uint16_t faults;
+    uint16_t slow_min[2], slow_max[2];  // per axis, x then y
+    uint32_t last_ms;                   // motion time of the last homing
+} homing_stats_t;
+
+extern homing_stats_t homing_stats;
+extern float head_x;
+extern float head_y;
+extern uint8_t motion_mask[8];
 
@@ -0,0 +1,85 @@
+#include "trace.h"
+#include "uart_esp.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_MAX_MARKS 8
+
+typedef struct {
+    uint16_t seq;
+    const char* point;
+    uint32_t us;
+} trace_mark_t;
+
+// Marks are only timestamped when they happen and sent later by trace_flush(), so the
+// ~20 ms a trace line takes at 9600 baud never delays the move or the gantry
+static trace_mark_t marks[TRACE_MAX_MARKS];
+static uint8_t mark_count = 0;
+static uint16_t local_seq = 1;
+
+uint32_t trace_now_us(void) {
+    uint8_t sreg = SREG;
+    cli();
+    uint32_t periods = timer4_periods;
+    uint16_t ticks = TCNT4;
+    // compare match happened but the ISR hasn't run yet: TCNT4 already wrapped
+    if ((TIFR4 & (1 << OCF4A)) && ticks < TRACE_TICKS_PER_PERIOD / 2) {
+        periods++;
+    }
+    SREG = sreg;
+    return (periods * TRACE_TICKS_PER_PERIOD + ticks) * TRACE_US_PER_TICK;
+}
+
+uint16_t trace_next_local_seq(void) {
+    uint16_t seq = local_seq;
+    local_seq += 2;
+    if (local_seq > 32767) local_seq = 1;
+    return seq;
+}
+
+// Strip a "#n" suffix from a move line; returns n, 0 if the line had none
+uint16_t trace_take_seq(char* line) {
+    char* hash = strchr(line, '#');
+    if (hash == NULL) return 0;
+    *hash = '\0';
+    return (uint16_t)atoi(hash + 1);
+}
+
+void trace_mark(uint16_t seq, const char* point) {
+#if MOVE_TRACE
+    if (seq == 0 || mark_count == TRACE_MAX_MARKS) return;
+    marks[mark_count].seq = seq;
+    marks[mark_count].point = point;
+    marks[mark_count].us = trace_now_us();
+    mark_count++;
+#endif
+}
+
+void trace_flush(void) {
+#if MOVE_TRACE
+    char buf[40];
+    for (uint8_t i = 0; i < mark_count; i++) {
+        char point[8];
+        strncpy_P(point, marks[i].point, sizeof(point) - 1);
+        point[sizeof(point) - 1] = '\0';
+        snprintf_P(buf, sizeof(buf), PSTR("tr:%u:%s:%lu\n"), marks[i].seq, point, (unsigned long)marks[i].us);
+        uart1_send_string(buf);
+    }
+    mark_count = 0;
+#endif
+}
+
+// Send a detected move to the ESP, tagged with its sequence id when tracing
+void trace_send_move(const char* move, uint16_t seq) {
+    uart1_send_string(move);
+#if MOVE_TRACE
+    char buf[8];
+    snprintf_P(buf, sizeof(buf), PSTR("#%u"), seq);
+    uart1_send_string(buf);
+#endif
+    uart1_send_byte('\n');
+}
@@ -0,0 +1,28 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+// Move latency tracing. Each move carries a sequence id on the ESP link as a "#n" suffix
+// ("e2e4#7"); moves detected on this board get odd ids, the ESP numbers streamed moves
+// with even ids. Trace points are sent to the ESP as "tr:<seq>:<point>:<us>" lines, which
+// it forwards to its Serial Monitor log together with its own points.
+// Build with -DMOVE_TRACE=0 to send bare moves and no trace lines.
+#ifndef MOVE_TRACE
+#define MOVE_TRACE 1
+#endif
+
+// Timer4 runs at F_CPU/1024 = 64 us per tick and wraps at OCR4A (7812) every ~0.5 s
+#define TRACE_US_PER_TICK 64UL
+#define TRACE_TICKS_PER_PERIOD 7813UL
+
+extern volatile uint32_t timer4_periods;   // incremented by the Timer4 compare ISR
+
+uint32_t trace_now_us(void);
+uint16_t trace_next_local_seq(void);
+uint16_t trace_take_seq(char* line);
+void trace_mark(uint16_t seq, const char* point);     // point is a flash string, PSTR("a.rx")
+void trace_flush(void);
+void trace_send_move(const char* move, uint16_t seq);
+
+#endif
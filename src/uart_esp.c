@@ -1,6 +1,7 @@
 #include "uart_esp.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 
 #define F_CPU 16000000UL
 #define BAUD 9600
@@ -51,12 +52,25 @@ void uart1_send_string(const char *s)
     while (*s) uart1_send_byte((uint8_t)*s++);
 }
 
+// The same for a string in flash (PSTR)
+void uart1_send_string_P(const char *s)
+{
+    uint8_t c;
+    while ((c = pgm_read_byte(s++))) uart1_send_byte(c);
+}
+
 ISR(USART1_RX_vect)
 {
     uint8_t c = UDR1;
     rx_push(c);
 }
 
+// Bytes received that uart1_readline() hasn't taken yet
+uint8_t uart1_rx_pending(void)
+{
+    return rx_head != rx_tail;
+}
+
 uint8_t uart1_readline(char *out, uint8_t maxlen)
 {
     static uint8_t idx = 0;
@@ -7,6 +7,8 @@
 void uart1_init(void);
 void uart1_send_byte(uint8_t d);
 void uart1_send_string(const char *s);
+void uart1_send_string_P(const char *s);
+uint8_t uart1_rx_pending(void);
 uint8_t uart1_readline(char *out, uint8_t maxlen);
 
 #endif /* UART_ESP_H_ */